@@ -35,6 +35,11 @@
 #define LEP_POPULAR_H
 
 #include <LEP/mosp/config.h>
+#include <LEP/mosp/stats.h>
+#include <LEP/mosp/instance.h>
+#include <LEP/mosp/options.h>
+#include <LEP/mosp/mates.h>
+#include <vector>
 
 #ifdef LEDA_GE_V5
 #include <LEDA/graph/graph.h>
@@ -65,6 +70,7 @@ namespace mosp
      *  \param B The list of nodes on the right side of the bipartite graph.
      *  \param rank An edge array. Each entry corresponds to the rank of an edge.
      *  \param L A list of edges which after the algorithm will contain the computed matching.
+     *  \param stats If not nil, runtime statistics of the algorithm are recorded here.
      *  \return True if the matching is popular, false otherwise.
      *  \ingroup popular
      */
@@ -72,7 +78,52 @@ namespace mosp
 	    const leda::list<leda::node>& A, 
 	    const leda::list<leda::node>& B, 
 	    const leda::edge_array<int>& rank, 
-	    leda::list<leda::edge>& L );
+	    leda::list<leda::edge>& L,
+	    SolveStats* stats = 0 );
+
+    /*! \brief Compute a popular matching of a validated instance. 
+     *
+     *  As above, without validating the graph again.
+     *
+     *  \param I The instance.
+     *  \param L A list of edges which after the algorithm will contain the computed matching.
+     *  \param options Statistics and scratch memory of the solve, see SolveOptions.
+     *  \return True if the matching is popular, false otherwise.
+     *  \ingroup popular
+     */
+    bool BI_POPULAR_MATCHING( const Instance& I, 
+	    leda::list<leda::edge>& L,
+	    const SolveOptions& options = SolveOptions() );
+
+    /*! \brief Compute a popular matching of a validated instance as a mate array. 
+     *
+     *  As above, with the matching written from the solver state to a mate 
+     *  array, see mates.h, instead of a list of edges. Applicants matched 
+     *  to their last resort are free.
+     *
+     *  \param I The instance.
+     *  \param mate An array of MATE_ARRAY_SIZE(I.Graph()) entries, for instance in shared memory.
+     *  \param options Statistics and scratch memory of the solve, see SolveOptions.
+     *  \return True if the matching is popular, false otherwise.
+     *  \ingroup popular
+     */
+    bool BI_POPULAR_MATCHING( const Instance& I, 
+	    int32_t* mate,
+	    const SolveOptions& options );
+
+    /*! \brief Compute a popular matching of a validated instance as a mate array. 
+     *
+     *  As above, resizing the vector to MATE_ARRAY_SIZE(I.Graph()) entries.
+     *
+     *  \param I The instance.
+     *  \param mate The mate array.
+     *  \param options Statistics and scratch memory of the solve, see SolveOptions.
+     *  \return True if the matching is popular, false otherwise.
+     *  \ingroup popular
+     */
+    bool BI_POPULAR_MATCHING( const Instance& I, 
+	    std::vector<int32_t>& mate,
+	    const SolveOptions& options = SolveOptions() );
 
     /*! \brief Compute an approximate popular matching. 
      *
@@ -89,6 +140,7 @@ namespace mosp
      *  \param phase A value which contains the number of phases that the algorithm needed to 
      *               compute the resulting matching. It will be at most the value of the 
      *               parameter maxphase.
+     *  \param stats If not nil, runtime statistics of the algorithm are recorded here.
      *  \return True if the matching is popular, false otherwise.
      *  \ingroup popular
      */
@@ -98,7 +150,8 @@ namespace mosp
 	    const leda::edge_array<int>& rank, 
 	    int maxphase,
 	    leda::list< leda::edge >& L,
-	    int& phase );
+	    int& phase,
+	    SolveStats* stats = 0 );
 
     /*! \brief Compute an approximate popular matching. 
      *
@@ -112,6 +165,7 @@ namespace mosp
      *  \param phase A value which contains the number of phases that the algorithm needed to 
      *               compute the resulting matching. A value of 2 means that the algorithm found
      *               a popular matching.
+     *  \param stats If not nil, runtime statistics of the algorithm are recorded here.
      *  \return True if the matching is popular, false otherwise.
      *  \ingroup popular
      */
@@ -120,7 +174,132 @@ namespace mosp
 	    const leda::list<leda::node>& B, 
 	    const leda::edge_array<int>& rank, 
 	    leda::list< leda::edge >& L,
-	    int& phase );
+	    int& phase,
+	    SolveStats* stats = 0 );
+
+    /*! \brief Compute an approximate popular matching of a validated instance. 
+     *
+     *  As above, without validating the graph again.
+     *
+     *  \param I The instance.
+     *  \param maxphase The maximum phase that the algorithm will try to compute a matching.
+     *  \param L A list of edges which after the algorithm will contain the computed matching.
+     *  \param phase The number of phases that the algorithm needed.
+     *  \param options Statistics and scratch memory of the solve, see SolveOptions.
+     *  \return True if the matching is popular, false otherwise.
+     *  \ingroup popular
+     */
+    bool BI_APPROX_POPULAR_MATCHING( const Instance& I, 
+	    int maxphase,
+	    leda::list< leda::edge >& L,
+	    int& phase,
+	    const SolveOptions& options = SolveOptions() );
+
+    /*! \brief Compute an approximate popular matching of a validated instance. 
+     *
+     *  As above, without validating the graph again.
+     *
+     *  \param I The instance.
+     *  \param L A list of edges which after the algorithm will contain the computed matching.
+     *  \param phase The number of phases that the algorithm needed.
+     *  \param options Statistics and scratch memory of the solve, see SolveOptions.
+     *  \return True if the matching is popular, false otherwise.
+     *  \ingroup popular
+     */
+    bool BI_APPROX_POPULAR_MATCHING( const Instance& I, 
+	    leda::list< leda::edge >& L,
+	    int& phase,
+	    const SolveOptions& options = SolveOptions() );
+
+    class PopularMatching;
+
+    /*! \brief An approximate popular matching computation which advances one 
+     *         phase at a time.
+     *
+     *  BI_APPROX_POPULAR_MATCHING with a maximum phase \f$k\f$ returns the 
+     *  matching after the phases \f$1,\ldots,k+1\f$, or fewer if the matching 
+     *  becomes applicant complete or no edge can be added. Since every phase 
+     *  extends the state of the previous one, sweeping \f$k = 2,\ldots,K\f$ 
+     *  with this class costs \f$K+1\f$ phases in total instead of 
+     *  \f$O(K^2)\f$:
+     *  \code
+     *  mosp::ApproxPopularSolver s( I );
+     *  for( int k = 2; k <= K; ++k ) { 
+     *      while( s.Phase() <= k && s.Step() ) 
+     *          ;
+     *      s.Matching( L ); // the same as BI_APPROX_POPULAR_MATCHING( I, k, L, phase )
+     *  }
+     *  \endcode
+     *
+     *  The options are copied. A workspace given in them is used for the whole 
+     *  life of the solver and a time limit counts from construction. 
+     *  Statistics accumulate one PhaseStats entry per phase.
+     *
+     *  \ingroup popular
+     */
+    class ApproxPopularSolver
+    {
+        public:
+
+            /*! \brief Prepare the computation, no phase is run yet
+             *  \param I The instance. It must outlive the solver.
+             *  \param options Statistics, scratch memory and stopping conditions, see SolveOptions.
+             */
+            ApproxPopularSolver( const Instance& I, 
+                    const SolveOptions& options = SolveOptions() );
+
+            ~ApproxPopularSolver();
+
+            /*! \brief Run the next phase
+             *  \return False if no further phase will run, because the matching 
+             *          is applicant complete, no edge could be added or the 
+             *          solve was stopped.
+             */
+            bool Step();
+
+            /*! \brief Number of phases run so far */
+            int Phase() const;
+
+            /*! \brief Whether no further phase will run */
+            bool Finished() const;
+
+            /*! \brief Whether every applicant is matched, possibly to its last resort */
+            bool ApplicantComplete() const;
+
+            /*! \brief Whether the current matching is popular, that is applicant 
+             *         complete after at most two phases */
+            bool Popular() const;
+
+            /*! \brief Why the solver finished, SOLVE_DONE unless stopped */
+            SolveStatus Status() const;
+
+            /*! \brief Snapshot of the current matching
+             *  \param L Receives the matched edges of the instance graph, 
+             *           without the last resort edges.
+             */
+            void Matching( leda::list<leda::edge>& L ) const;
+
+            /*! \brief Snapshot of the current matching as a mate array, see mates.h
+             *  \param mate An array of MATE_ARRAY_SIZE(I.Graph()) entries, 
+             *              the applicants matched to their last resort are free.
+             *  \return The number of matched edges.
+             */
+            int Mates( int32_t* mate ) const;
+
+            /*! \brief Snapshot of the nodes which were even in the decomposition 
+             *         of every phase so far
+             *  \param even Receives the labels, indexed by the nodes of the instance graph.
+             */
+            void AlwaysEven( leda::node_array<bool>& even ) const;
+
+        private:
+            const Instance& I;
+            PopularMatching* impl;
+
+            // not copyable
+            ApproxPopularSolver( const ApproxPopularSolver& );
+            ApproxPopularSolver& operator=( const ApproxPopularSolver& );
+    };
 
 
     /*! \brief Compute the unpopularity factor of a matching. 
@@ -136,9 +315,10 @@ namespace mosp
      *  \param rank An edge array. Each entry corresponds to the rank of an edge.
      *  \param M The matching to test in the following form. A list of edges.
      *  \param factor Contains the unpopularity factor if it is finite. Undefined otherwise.
+     *  \param stats If not nil, runtime statistics of the computation are recorded here.
      *  \pre   All edges are directed from A to B.
      *  \pre   The adjacency lists of the graph must be sorted according to the rank parameter. This
-     *         means that in LEDA someone has to call G.sort_edges( rank ) before calling this function.
+     *         means that someone has to call SORT_EDGES_BY_RANK( G, rank ) before calling this function.
      *  \return True if the matching has a finite unpopularity factor, false if infinite.
      *  \ingroup popular
      */
@@ -146,7 +326,24 @@ namespace mosp
 	    const list<node>& A,  const list<node>& B,
 	    const edge_array<int>& rank,
 	    const list<edge>& M,
-	    int &factor );
+	    int &factor,
+	    SolveStats* stats = 0 );
+
+    /*! \brief Compute the unpopularity factor of a matching of a prepared instance. 
+     *  
+     *  As above. The adjacency lists of the graph are sorted by rank again on return.
+     *
+     *  \param I The instance.
+     *  \param M The matching to test as a list of edges.
+     *  \param factor Contains the unpopularity factor if it is finite. Undefined otherwise.
+     *  \param stats If not nil, runtime statistics of the computation are recorded here.
+     *  \return True if the matching has a finite unpopularity factor, false if infinite.
+     *  \ingroup popular
+     */
+    bool BI_UNPOPULARITY_FACTOR( const Instance& I,
+	    const list<edge>& M,
+	    int &factor,
+	    SolveStats* stats = 0 );
 
     /*! \brief Compute a popular matching in a capacitated instance. 
      *
@@ -159,6 +356,7 @@ namespace mosp
      *  \param capacity Node capacities.
      *  \param L A list of edges which after the algorithm will contain the computed matching.
      *           Undefined if no popular matching exists.
+     *  \param stats If not nil, runtime statistics of the algorithm are recorded here.
      *  \return True if the matching is popular, false otherwise.
      *  \pre Capacities of the left side of the graph have to be 1, capacities of the right
      *       side have to be positive.
@@ -171,7 +369,24 @@ namespace mosp
             const list<node>& B, 
             const edge_array<int>& rank, 
             const node_array<int>& capacity,
-            list<edge>& L );
+            list<edge>& L,
+            SolveStats* stats = 0 );
+
+    /*! \brief Compute a popular matching of a validated capacitated instance. 
+     *
+     *  As above, without validating the graph again. If the instance has no 
+     *  capacities all capacities are one.
+     *
+     *  \param I The instance.
+     *  \param L A list of edges which after the algorithm will contain the computed matching.
+     *           Undefined if no popular matching exists.
+     *  \param options Statistics and scratch memory of the solve, see SolveOptions.
+     *  \return True if the matching is popular, false otherwise.
+     *  \ingroup popular
+     */
+    bool BI_POPULAR_CAPACITATED_MATCHING( const Instance& I, 
+            list<edge>& L,
+            const SolveOptions& options = SolveOptions() );
 
     /*! \brief Compute the unpopularity margin of a matching. 
      *  
@@ -184,6 +399,7 @@ namespace mosp
      *  \param B The list of nodes on the right side of the bipartite graph.
      *  \param rank An edge array. Each entry corresponds to the rank of an edge.
      *  \param M The matching to test as a list of edges.
+     *  \param stats If not nil, runtime statistics of the computation are recorded here.
      *  \pre   All edges are directed from A to B.
      *  \return The unpopularity margin
      *  \ingroup popular
@@ -191,7 +407,73 @@ namespace mosp
     int BI_UNPOPULARITY_MARGIN( graph& G,
 	    const list<node>& A,  const list<node>& B,
 	    const edge_array<int>& rank,
-	    const list<edge>& M );
+	    const list<edge>& M,
+	    SolveStats* stats = 0 );
+
+    /*! \brief Compute the unpopularity margin of a matching of a prepared instance. 
+     *  
+     *  As above. The adjacency lists of the graph are sorted by rank again on return.
+     *
+     *  \param I The instance.
+     *  \param M The matching to test as a list of edges.
+     *  \param stats If not nil, runtime statistics of the computation are recorded here.
+     *  \return The unpopularity margin
+     *  \ingroup popular
+     */
+    int BI_UNPOPULARITY_MARGIN( const Instance& I,
+	    const list<edge>& M,
+	    SolveStats* stats = 0 );
+
+    /*! \brief Check whether a matching of a prepared instance is popular, in linear time. 
+     *  
+     *  The matching, with every free applicant matched to its last resort 
+     *  post, is checked against the characterization of Abraham, Irving, 
+     *  Kavitha and Mehlhorn. Let \f$G_1\f$ be the graph of the first 
+     *  choice edges, those of the smallest rank of each applicant, and 
+     *  call a post even if it is even in the decomposition of \f$G_1\f$ 
+     *  into even, odd and unreachable nodes. The matching \f$M\f$ is 
+     *  popular if and only if 
+     *  - \f$M \cap G_1\f$ is a maximum matching of \f$G_1\f$, and 
+     *  - every applicant \f$a\f$ is matched to one of its first choices 
+     *    \f$f(a)\f$ or to one of \f$s(a)\f$, its most preferred even posts 
+     *    of larger rank, which is its last resort post if there is none. 
+     *
+     *  With strict preferences this says that every first choice post is 
+     *  matched and every applicant is matched to \f$f(a)\f$ or \f$s(a)\f$. 
+     *  The check is one alternating breadth first search in \f$G_1\f$ from 
+     *  the posts left free by \f$M \cap G_1\f$, which finds the even posts 
+     *  and the applicants at the end of an augmenting path, and one scan of 
+     *  the preference lists, thus it takes time \f$O(n+m)\f$, much less than 
+     *  solving the instance or BI_UNPOPULARITY_MARGIN.
+     *
+     *  \param I The instance.
+     *  \param M The matching to check as a list of edges.
+     *  \param violating Receives the applicants which violate a condition: 
+     *         the free applicants of \f$M \cap G_1\f$ at the end of an 
+     *         augmenting path, the applicants matched outside of 
+     *         \f$f(a) \cup s(a)\f$, and the applicants sharing a node with 
+     *         another matched edge if M is not a matching.
+     *  \return True if the matching is popular, that is violating is empty.
+     *  \ingroup popular
+     */
+    bool BI_IS_POPULAR_MATCHING( const Instance& I,
+	    const leda::list<leda::edge>& M,
+	    leda::list<leda::node>& violating );
+
+    /*! \brief Check whether a matching of a prepared instance given as a mate array is popular, in linear time. 
+     *  
+     *  As above, for a mate array, see mates.h. An applicant whose mate is 
+     *  not a neighbor or does not have it as its mate violates the check.
+     *
+     *  \param I The instance.
+     *  \param mate An array of MATE_ARRAY_SIZE(I.Graph()) entries, each NO_MATE or a node index.
+     *  \param violating Receives the applicants which violate a condition.
+     *  \return True if the matching is popular, that is violating is empty.
+     *  \ingroup popular
+     */
+    bool BI_IS_POPULAR_MATCHING( const Instance& I,
+	    const int32_t* mate,
+	    leda::list<leda::node>& violating );
 
 
 }
@@ -35,6 +35,12 @@
 #define RANK_MAX_MATCHING_H
 
 #include <LEP/mosp/config.h>
+#include <LEP/mosp/stats.h>
+#include <LEP/mosp/instance.h>
+#include <LEP/mosp/options.h>
+#include <LEP/mosp/mates.h>
+#include <iostream>
+#include <vector>
 
 #ifdef LEDA_GE_V5
 #include <LEDA/core/array.h>
@@ -59,16 +65,147 @@ namespace mosp
  * matching which uses the largest possible number of rank one edges, and 
  * subject to this constraint the largest possible number of rank two edges and so on. 
  * The matching is returned as a list of edges. 
- * The running time is \f$O(r \sqrt{n} m)\f$ where \f$r\f$ is the maximum rank of an edge in the input.
+ * The running time is \f$O(\min(n+r, r \sqrt{n}) m)\f$ where \f$r\f$ is the maximum rank of an edge in the input.
+ * Each phase uses Hopcroft-Karp rounds while many augmentations may remain and 
+ * switches to single augmenting path searches once only a few can remain.
  *  \param G The graph
  *  \param rank A rank function on the edges.
+ *  \param stats If not nil, runtime statistics of the algorithm are recorded here.
  *  \pre G must be simple, loopfree and bipartite.
  *  \pre rank is a positive integer function on the edges of the graph.
  *  \return A list of edges with the resulting matching.
  *  \ingroup rankmax
  */
 leda::list<leda::edge> BI_RANK_MAX_MATCHING( leda::graph& G, 
-                          const leda::edge_array<int>& rank );
+                          const leda::edge_array<int>& rank,
+                          SolveStats* stats = 0 );
+
+/*! \brief Compute a rank-maximal matching of a validated instance.
+ *
+ * As BI_RANK_MAX_MATCHING above, without validating the graph again.
+ *  \param I The instance
+ *  \param options Statistics and scratch memory of the solve, see SolveOptions.
+ *  \return A list of edges with the resulting matching.
+ *  \ingroup rankmax
+ */
+leda::list<leda::edge> BI_RANK_MAX_MATCHING( const Instance& I, 
+                const SolveOptions& options = SolveOptions() );
+
+/*! \brief Compute a rank-maximal matching of a validated instance as a mate array.
+ *
+ * As BI_RANK_MAX_MATCHING above, with the matching written from the 
+ * solver state to a mate array, see mates.h, instead of a list of edges.
+ *  \param I The instance
+ *  \param mate An array of MATE_ARRAY_SIZE(I.Graph()) entries, for instance in shared memory.
+ *  \param options Statistics and scratch memory of the solve, see SolveOptions.
+ *  \return The number of matched edges.
+ *  \ingroup rankmax
+ */
+int BI_RANK_MAX_MATCHING( const Instance& I, int32_t* mate, 
+                const SolveOptions& options );
+
+/*! \brief Compute a rank-maximal matching of a validated instance as a mate array.
+ *
+ * As above, resizing the vector to MATE_ARRAY_SIZE(I.Graph()) entries.
+ *  \param I The instance
+ *  \param mate The mate array.
+ *  \param options Statistics and scratch memory of the solve, see SolveOptions.
+ *  \return The number of matched edges.
+ *  \ingroup rankmax
+ */
+int BI_RANK_MAX_MATCHING( const Instance& I, std::vector<int32_t>& mate, 
+                const SolveOptions& options = SolveOptions() );
+
+/*! \brief Representations of the adjacency lists of BI_RANK_MAX_MATCHING_COMPACT.
+ *  \ingroup rankmax
+ */
+enum AdjacencyEncoding { 
+    ADJACENCY_PLAIN = 0,    //!< arrays of 32-bit node indices and narrow ranks
+    ADJACENCY_VARINT = 1,   //!< delta and group varint compressed lists, plain from \f$2^{29}\f$ nodes on
+    ADJACENCY_MAPPED = 2    //!< the plain lists in a memory-mapped file of SolveOptions::scratchDirectory
+};
+
+/*! \brief Compute a rank-maximal matching of a bipartite graph in compact state.
+ *
+ * The algorithm of BI_RANK_MAX_MATCHING with the same running time, on 
+ * solver state of 32-bit node indices, narrow ranks and bit planes instead 
+ * of node and edge arrays, about 10 bytes per edge when the maximum rank 
+ * is less than 256. The adjacency lists are plain arrays, compressed lists 
+ * or plain lists in a scratch file mapped in memory, as selected by the 
+ * encoding. The graph is not modified. The instance must have fewer than 
+ * \f$2^{32}-1\f$ nodes.
+ *
+ * The engine is BI_RANK_MAX_MATCHING_COMPACT_T of 
+ * RANK_MAX_MATCHING_COMPACT_T.h, which also runs on a leda::GRAPH or a 
+ * CsrGraph without copying it into an Instance.
+ *  \param G The graph
+ *  \param rank A rank function on the edges.
+ *  \param stats If not nil, runtime statistics of the algorithm are recorded here,
+ *               including the bytes of solver state.
+ *  \param encoding The representation of the adjacency lists.
+ *  \pre G must be simple, loopfree and bipartite.
+ *  \pre rank is a positive integer function on the edges of the graph.
+ *  \return A list of edges with the resulting matching.
+ *  \ingroup rankmax
+ */
+leda::list<leda::edge> BI_RANK_MAX_MATCHING_COMPACT( leda::graph& G,
+                          const leda::edge_array<int>& rank,
+                          SolveStats* stats = 0,
+                          AdjacencyEncoding encoding = ADJACENCY_PLAIN );
+
+/*! \brief Compute a rank-maximal matching of a validated instance in compact state.
+ *
+ * As BI_RANK_MAX_MATCHING_COMPACT above, without validating the graph again.
+ * All solver state is allocated in the workspace.
+ *  \param I The instance
+ *  \param options Statistics and scratch memory of the solve, see SolveOptions.
+ *  \param encoding The representation of the adjacency lists.
+ *  \return A list of edges with the resulting matching.
+ *  \ingroup rankmax
+ */
+leda::list<leda::edge> BI_RANK_MAX_MATCHING_COMPACT( const Instance& I,
+                const SolveOptions& options = SolveOptions(),
+                AdjacencyEncoding encoding = ADJACENCY_PLAIN );
+
+/*! \brief Compute a rank-maximal matching of a validated instance in compact state as a mate array.
+ *
+ * As BI_RANK_MAX_MATCHING_COMPACT above, with the mates of the solver 
+ * state copied to a mate array, see mates.h, instead of searching the 
+ * matched edges in the adjacency lists.
+ *  \param I The instance
+ *  \param mate An array of MATE_ARRAY_SIZE(I.Graph()) entries, for instance in shared memory.
+ *  \param options Statistics and scratch memory of the solve, see SolveOptions.
+ *  \param encoding The representation of the adjacency lists.
+ *  \return The number of matched edges.
+ *  \ingroup rankmax
+ */
+int BI_RANK_MAX_MATCHING_COMPACT( const Instance& I, int32_t* mate,
+                const SolveOptions& options,
+                AdjacencyEncoding encoding = ADJACENCY_PLAIN );
+
+/*! \brief Compute a rank-maximal matching of a validated instance in compact state as a mate array.
+ *
+ * As above, resizing the vector to MATE_ARRAY_SIZE(I.Graph()) entries.
+ *  \param I The instance
+ *  \param mate The mate array.
+ *  \param options Statistics and scratch memory of the solve, see SolveOptions.
+ *  \param encoding The representation of the adjacency lists.
+ *  \return The number of matched edges.
+ *  \ingroup rankmax
+ */
+int BI_RANK_MAX_MATCHING_COMPACT( const Instance& I, std::vector<int32_t>& mate,
+                const SolveOptions& options = SolveOptions(),
+                AdjacencyEncoding encoding = ADJACENCY_PLAIN );
+
+/*! \brief Bytes of solver state of BI_RANK_MAX_MATCHING_COMPACT on an instance.
+ *
+ * For ADJACENCY_PLAIN. The workspace rounds each of the fourteen arrays up 
+ * to 16 bytes, thus SolveStats::stateBytes exceeds this by less than 256 bytes.
+ *  \param I The instance
+ *  \return The number of bytes.
+ *  \ingroup rankmax
+ */
+size_t BI_RANK_MAX_MATCHING_COMPACT_BYTES( const Instance& I );
 
 /*! \brief Compute a rank-maximal matching of a bipartite graph.
  *
@@ -78,19 +215,34 @@ leda::list<leda::edge> BI_RANK_MAX_MATCHING( leda::graph& G,
  * and so on. 
  * The matching is returned as a list of edges. 
  * This procedure solves the problem by reducing it to the maximum 
- * weight matching problem, and therefore the running time is 
- * \f$O( n^2 ( m + n \log n ))\f$. The second \f$n\f$ comes from the possibly
- * large cost of arithmetic since the reduction involves edge weights
- * which can be as large as \f$n^n\f$. The space requirement is \f$O(mn + n^2)\f$.
+ * weight matching problem. The reduction involves edge weights which 
+ * can be as large as \f$n^r\f$, where \f$r\f$ is the number of distinct ranks. 
+ * When these fit in a long the running time is \f$O( n ( m + n \log n ))\f$.
+ * Otherwise the weights are handled as vectors of dimension \f$r\f$ which 
+ * are compared lexicographically, resulting in a running time of
+ * \f$O( r n ( m + n \log n ))\f$ and space \f$O(r n + m)\f$.
  *  \param G The graph
  *  \param rank A rank function on the edges.
+ *  \param stats If not nil, runtime statistics of the algorithm are recorded here.
  *  \pre G must be simple, loopfree and bipartite.
  *  \pre rank is a positive integer function on the edges of the graph.
  *  \return A list of edges with the resulting matching.
  *  \ingroup rankmax
  */
 leda::list<leda::edge> BI_RANK_MAX_MATCHING_MWMR( leda::graph& G, 
-                const leda::edge_array<int>& rank );
+                const leda::edge_array<int>& rank,
+                SolveStats* stats = 0 );
+
+/*! \brief Compute a rank-maximal matching of a validated instance.
+ *
+ * As BI_RANK_MAX_MATCHING_MWMR above, without validating the graph again.
+ *  \param I The instance
+ *  \param options Statistics and scratch memory of the solve, see SolveOptions.
+ *  \return A list of edges with the resulting matching.
+ *  \ingroup rankmax
+ */
+leda::list<leda::edge> BI_RANK_MAX_MATCHING_MWMR( const Instance& I, 
+                const SolveOptions& options = SolveOptions() );
 
 /*! \brief Compute a rank-maximal matching of a bipartite graph.
  *
@@ -105,14 +257,245 @@ leda::list<leda::edge> BI_RANK_MAX_MATCHING_MWMR( leda::graph& G,
  * of an edge in the input and linear space.
  *  \param G The graph
  *  \param rank A rank function on the edges.
+ *  \param stats If not nil, runtime statistics of the algorithm are recorded here.
  *  \pre G must be simple, loopfree and bipartite.
  *  \pre rank is a positive integer function on the edges of the graph.
  *  \return A list of edges with the resulting matching.
  *  \ingroup rankmax
  */
 leda::list<leda::edge> DBI_RANK_MAX_MATCHING_MWMR( leda::graph& G, 
+                const leda::edge_array<int>& rank,
+                SolveStats* stats = 0 );
+
+/*! \brief Compute a rank-maximal matching of a validated instance.
+ *
+ * As DBI_RANK_MAX_MATCHING_MWMR above, without validating the graph again.
+ *  \param I The instance
+ *  \param options Statistics and scratch memory of the solve, see SolveOptions.
+ *  \return A list of edges with the resulting matching.
+ *  \ingroup rankmax
+ */
+leda::list<leda::edge> DBI_RANK_MAX_MATCHING_MWMR( const Instance& I, 
+                const SolveOptions& options = SolveOptions() );
+
+/*! \brief The rank-maximal matching engines.
+ *
+ *  The numbering follows the -a option of mosp_gml.
+ *  \ingroup rankmax
+ */
+enum RankMaxAlgorithm { 
+    RANK_MAX_AUTO = 0,            //!< select automatically
+    RANK_MAX_COMBINATORIAL = 1,   //!< BI_RANK_MAX_MATCHING
+    RANK_MAX_IMPLICIT_MWM = 2,    //!< DBI_RANK_MAX_MATCHING_MWMR
+    RANK_MAX_EXPLICIT_MWM = 3     //!< BI_RANK_MAX_MATCHING_MWMR
+};
+
+/*! \brief Name of the function implementing an engine.
+ *  \ingroup rankmax
+ */
+const char* RANK_MAX_ALGORITHM_NAME( RankMaxAlgorithm a );
+
+/*! \brief Cheap features of a rank-maximal matching instance.
+ *
+ *  These are the inputs of the cost model of RankMaxSelector.
+ *  \ingroup rankmax
+ */
+struct RankMaxFeatures
+{
+    /*! \brief Number of nodes. */
+    int nodes;
+
+    /*! \brief Number of edges. */
+    int edges;
+
+    /*! \brief The maximum rank of an edge. */
+    int maxRank;
+
+    /*! \brief Number of distinct ranks, that is the number of non-empty phases. */
+    int distinctRanks;
+
+    /*! \brief Fraction of the edges having the minimum rank. */
+    double firstRankFraction;
+
+    /*! \brief Fraction of the edges in the largest rank class. */
+    double largestRankFraction;
+
+    /*! \brief Fraction of the edges whose source has another outgoing edge of 
+     *         the same rank. With edges directed from applicants to posts this is 
+     *         the density of ties in the preference lists. */
+    double tieDensity;
+
+    /*! \brief Create the features of the empty instance. */
+    RankMaxFeatures() : nodes( 0 ), edges( 0 ), maxRank( 0 ), distinctRanks( 0 ), 
+        firstRankFraction( 0.0 ), largestRankFraction( 0.0 ), tieDensity( 0.0 ) 
+    {
+    }
+};
+
+/*! \brief Extract the features of a rank-maximal matching instance.
+ *
+ *  The ranks are sorted, in time \f$O(n + m \log m)\f$ and space \f$O(n + m)\f$ 
+ *  independent of the values of the ranks.
+ *  \param G The graph
+ *  \param rank A rank function on the edges.
+ *  \return The features of the instance.
+ *  \ingroup rankmax
+ */
+RankMaxFeatures RANK_MAX_MATCHING_FEATURES( const leda::graph& G, 
                 const leda::edge_array<int>& rank );
 
+/*! \brief Extract the features of a prepared rank-maximal matching instance.
+ *
+ *  The rank classes and the rank-sorted adjacency lists of the instance are 
+ *  used, in time \f$O(n + m)\f$. The ties are counted at the nodes of the 
+ *  left side.
+ *  \param I The instance
+ *  \return The features of the instance.
+ *  \ingroup rankmax
+ */
+RankMaxFeatures RANK_MAX_MATCHING_FEATURES( const Instance& I );
+
+/*! \brief Cost model selecting a rank-maximal matching engine.
+ *
+ *  The predicted running time of each engine is a log-linear function of the 
+ *  instance features, 
+ *  \f$ \exp( c_0 + c_1 \log n + c_2 \log m + c_3 \log d + c_4 t + c_5 f ) \f$, 
+ *  where \f$d\f$ is the number of distinct ranks, \f$t\f$ the tie density and 
+ *  \f$f\f$ the fraction of edges of the first rank. The engine with the smallest 
+ *  predicted time is selected. 
+ *
+ *  The default coefficients are a least squares fit of the running times 
+ *  reported by mosp_bench over all its generators. Since they depend on the 
+ *  machine and the LEDA version they can be replaced, either by calling 
+ *  SetModel() or by reading a model file with one line per engine
+ *  \verbatim <engine number> c0 c1 c2 c3 c4 c5 \endverbatim
+ *  and a line \verbatim range <nodes> <edges> \endverbatim giving the 
+ *  largest instances the model was fitted on. The model is not extrapolated: 
+ *  instances with more nodes or more edges are solved by the combinatorial 
+ *  engine. Lines starting with # are ignored. Finally the selection can be 
+ *  forced to a particular engine.
+ *  \ingroup rankmax
+ */
+class RankMaxSelector
+{
+    public:
+        /*! \brief Number of coefficients of each model */
+        enum { COEFFICIENTS = 6 };
+
+        /*! \brief Create a selector with the default model */
+        RankMaxSelector();
+
+        /*! \brief Always select an engine, RANK_MAX_AUTO restores the model */
+        void Force( RankMaxAlgorithm a ) { forced = a; }
+
+        /*! \brief Set the coefficients of the model of an engine
+         *  \param a The engine
+         *  \param c An array of COEFFICIENTS coefficients
+         */
+        void SetModel( RankMaxAlgorithm a, const double* c );
+
+        /*! \brief Set the largest instance the model was fitted on
+         *  \param nodes The maximum number of nodes
+         *  \param edges The maximum number of edges
+         */
+        void SetRange( int nodes, int edges ) { maxNodes = nodes; maxEdges = edges; }
+
+        /*! \brief Predicted running time of an engine in seconds */
+        double PredictedTime( RankMaxAlgorithm a, const RankMaxFeatures& f ) const;
+
+        /*! \brief Select the engine for an instance */
+        RankMaxAlgorithm Select( const RankMaxFeatures& f ) const;
+
+        /*! \brief Read a model file, engines not mentioned keep their model
+         *  \return False if the input is malformed
+         */
+        bool Read( std::istream& i );
+
+        /*! \brief Write the model in the format accepted by Read() */
+        void Print( std::ostream& o ) const;
+
+    private:
+        RankMaxAlgorithm forced;
+        double coef[ 4 ][ COEFFICIENTS ];
+        int maxNodes;
+        int maxEdges;
+};
+
+/*! \brief Compute a rank-maximal matching of a bipartite graph, selecting 
+ *         the engine automatically.
+ *
+ * The features of the instance are extracted by RANK_MAX_MATCHING_FEATURES 
+ * and the problem is solved by the engine chosen by the selector. The choice 
+ * is recorded in stats.
+ *  \param G The graph
+ *  \param rank A rank function on the edges.
+ *  \param stats If not nil, runtime statistics of the algorithm are recorded here.
+ *  \param selector The selector to use, if nil the default model is used.
+ *  \param chosen If not nil, the engine used is stored here.
+ *  \pre G must be simple, loopfree and bipartite.
+ *  \pre rank is a positive integer function on the edges of the graph.
+ *  \return A list of edges with the resulting matching.
+ *  \ingroup rankmax
+ */
+leda::list<leda::edge> RANK_MAX_MATCHING_AUTO( leda::graph& G, 
+                const leda::edge_array<int>& rank,
+                SolveStats* stats = 0,
+                const RankMaxSelector* selector = 0,
+                RankMaxAlgorithm* chosen = 0 );
+
+/*! \brief Compute a rank-maximal matching of a validated instance, selecting 
+ *         the engine automatically.
+ *
+ * As RANK_MAX_MATCHING_AUTO above, without validating the graph again.
+ *  \param I The instance
+ *  \param options Statistics and scratch memory of the solve, see SolveOptions.
+ *  \param selector The selector to use, if nil the default model is used.
+ *  \param chosen If not nil, the engine used is stored here.
+ *  \return A list of edges with the resulting matching.
+ *  \ingroup rankmax
+ */
+leda::list<leda::edge> RANK_MAX_MATCHING_AUTO( const Instance& I, 
+                const SolveOptions& options = SolveOptions(),
+                const RankMaxSelector* selector = 0,
+                RankMaxAlgorithm* chosen = 0 );
+
+/*! \brief Compute a rank-maximal matching of a bipartite graph by solving
+ *         its connected components independently.
+ *
+ * The instance is first preprocessed. Let \f$r\f$ be the minimum rank of an 
+ * edge. If a node has exactly one incident edge of rank \f$r\f$, the other 
+ * endpoint of this edge is matched by an edge of rank \f$r\f$ in every 
+ * rank-maximal matching, and therefore its incident edges of rank larger than 
+ * \f$r\f$ are removed. The remaining graph is split into connected components 
+ * using union-find over the edges. Components which are stars are solved 
+ * directly by picking an edge of minimum rank. The rest are copied into 
+ * graphs of their own and solved by RANK_MAX_MATCHING_AUTO, which selects an 
+ * engine for each component separately. The matchings of the components are 
+ * merged into the result.
+ *
+ * Component-level information is recorded in stats, the phases of all 
+ * components are appended in the order the components were solved.
+ *
+ *  \param G The graph
+ *  \param rank A rank function on the edges.
+ *  \param stats If not nil, runtime statistics of the algorithm are recorded here.
+ *  \param threads Number of threads solving components concurrently. Values 
+ *         larger than one are ignored unless LEDA is configured thread-safe, 
+ *         that is LEDA_MULTI_THREAD is defined, and the library was not 
+ *         compiled with MOSP_NO_THREADS.
+ *  \param selector The selector to use for each component, if nil the default 
+ *         model is used.
+ *  \pre G must be simple, loopfree and bipartite.
+ *  \pre rank is a positive integer function on the edges of the graph.
+ *  \return A list of edges with the resulting matching.
+ *  \ingroup rankmax
+ */
+leda::list<leda::edge> RANK_MAX_MATCHING_DECOMPOSED( leda::graph& G, 
+                const leda::edge_array<int>& rank,
+                SolveStats* stats = 0,
+                int threads = 1,
+                const RankMaxSelector* selector = 0 );
+
 
 /*! \brief Compute the profile of a matching.
  * 
@@ -157,6 +540,7 @@ bool DEBUG_is_valid_matching( const leda::graph &G,
  *  \param B Nodes of the right-side partition of the bipartite graph.
  *  \param capacity Node capacities
  *  \param rank A rank function on the edges.
+ *  \param stats If not nil, runtime statistics of the algorithm are recorded here.
  *  \pre G must be simple, loopfree and bipartite.
  *  \pre rank is a positive integer function on the edges of the graph.
  *  \pre Capacities must be positive.
@@ -169,9 +553,22 @@ leda::list<leda::edge> BI_RANK_MAX_CAPACITATED_MATCHING(
             const leda::list<leda::node>& A, 
             const leda::list<leda::node>& B, 
             const leda::node_array<int>& capacity,
-            const leda::edge_array<int>& rank 
+            const leda::edge_array<int>& rank,
+            SolveStats* stats = 0
             );
 
+/*! \brief Compute a rank-maximal matching of a validated capacitated instance.
+ *
+ * As BI_RANK_MAX_CAPACITATED_MATCHING above, without validating the graph again.
+ * If the instance has no capacities all capacities are one.
+ *  \param I The instance
+ *  \param options Statistics and scratch memory of the solve, see SolveOptions.
+ *  \return The list of edges of the computed matching.
+ *  \ingroup rankmax
+ */
+leda::list<leda::edge> BI_RANK_MAX_CAPACITATED_MATCHING( const Instance& I, 
+            const SolveOptions& options = SolveOptions() );
+
 // A procedure to check whether a list of edges is 
 // a matching, for debugging and testing purposes.
 bool DEBUG_is_valid_matching( const leda::graph &G, 
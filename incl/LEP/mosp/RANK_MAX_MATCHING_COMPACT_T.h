@@ -0,0 +1,1234 @@
+//
+// This program can be freely used in an academic environment
+// ONLY for research purposes, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    an acknowledgment in the product documentation is required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// Any other use is strictly prohibited by the author, without an explicit
+// permission.
+//
+// Note that this program uses the LEDA library, which is NOT free. For more
+// details visit Algorithmic Solutions at http://www.algorithmic-solutions.com/
+//
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+// ! Any commercial use of this software is strictly !
+// ! prohibited without explicit permission by the   !
+// ! author.                                         !
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// Copyright (C) 2004-2010 Dimitrios Michail <dimitrios.michail@gmail.com>
+//
+
+/*! \file RANK_MAX_MATCHING_COMPACT_T.h
+ *  \brief The engine of BI_RANK_MAX_MATCHING_COMPACT, templated on the graph type.
+ *
+ *  \ingroup rankmax
+ */
+
+#ifndef LEP_RANK_MAX_MATCHING_COMPACT_T_H
+#define LEP_RANK_MAX_MATCHING_COMPACT_T_H
+
+#include <LEP/mosp/config.h>
+#include <LEP/mosp/options.h>
+#include <LEP/mosp/stats.h>
+#include <LEP/mosp/workspace.h>
+#include <LEP/mosp/graph_traits.h>
+#include <LEP/mosp/RANK_MAX_MATCHING.h>
+#include <LEP/mosp/compact_state.h>
+#include <LEP/mosp/mates.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <math.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#ifdef LEDA_GE_V5
+#include <LEDA/core/list.h>
+#else
+#include <LEDA/list.h>
+#endif
+
+namespace mosp
+{
+
+    // the engine of BI_RANK_MAX_MATCHING_COMPACT, not part of the interface
+    namespace compact { 
+
+    // the label planes
+    enum { LABEL_A = 0, LABEL_REACHED = 1, LABEL_ODD = 2, LABEL_PLANES = 3 };
+
+    // no node, the mate of a free node
+    const unsigned int NONE = 0xffffffffu;
+
+    // The adjacency lists as arrays holding the 32-bit index of the 
+    // opposite node and the narrow rank of each entry, copied from the 
+    // rank sorted lists of the graph. Each edge has an entry at both 
+    // endpoints. Pruned entries are removed by moving the end of the list.
+    //
+    // An adjacency representation provides a cursor type, first() and 
+    // next() to scan a list in rank order and filter() to remove the 
+    // entries rejected by a predicate, keeping the order of the others. 
+    // A pruning pass calls filter() on every list in index order, between 
+    // start_filter() and finish_filter(). transferred() reports the bytes 
+    // moved to and from external memory since its last call.
+    template<int Bytes>
+    class plain_adjacency
+    { 
+        public:
+            typedef typename narrow_rank<Bytes>::type rank_type;
+            typedef rank_type stamp_type;
+            typedef unsigned int cursor_type;
+
+            template<class Traits> 
+            plain_adjacency( const Traits& t, Workspace& ws, int n, const SolveOptions& );
+
+            void first( unsigned int v, cursor_type& c ) const { c = begin[v]; }
+
+            bool next( unsigned int v, cursor_type& c, unsigned int& w, int& r ) const { 
+                if ( c == end[v] ) return false;
+                w = adj[c];
+                r = rank[c];
+                c++;
+                return true;
+            }
+
+            template<class Keep> 
+            void filter( unsigned int v, Keep& keep ) { 
+                unsigned int j = begin[v];
+                for( unsigned int k = begin[v]; k < end[v]; ++k ) 
+                    if ( keep( adj[k], rank[k] ) ) { 
+                        adj[j] = adj[k];
+                        rank[j] = rank[k];
+                        j++;
+                    }
+                end[v] = j;
+            }
+
+            void start_filter() {}
+            void finish_filter() {}
+            void transferred( size_t& read, size_t& written ) { read = written = 0; }
+
+        private:
+            unsigned int* begin;    // first entry of each list, n + 1 entries
+            unsigned int* end;      // past the last entry which is not pruned
+            unsigned int* adj;      // index of the opposite node of each entry
+            rank_type* rank;        // rank of each entry
+    };
+
+    template<int Bytes> template<class Traits> 
+    plain_adjacency<Bytes>::plain_adjacency( const Traits& t, Workspace& ws, int n, 
+            const SolveOptions& ) 
+        : begin( workspace_array<unsigned int>( ws, n + 1 ) ),
+          end( workspace_array<unsigned int>( ws, n ) ),
+          adj( workspace_array<unsigned int>( ws, 2 * t.number_of_edges() ) ),
+          rank( workspace_array<rank_type>( ws, 2 * t.number_of_edges() ) )
+    {
+        typedef typename Traits::node_type node_type;
+        typedef typename Traits::adj_iterator adj_iterator;
+
+        for( int i = 0; i <= n; ++i ) 
+            begin[i] = 0;
+        for( node_type v = t.first_node(); t.is_node( v ); v = t.next_node( v ) ) 
+            begin[ t.index(v) + 1 ] = t.degree( v );
+        for( int i = 1; i <= n; ++i ) 
+            begin[i] += begin[i-1];
+
+        for( int i = 0; i < n; ++i ) 
+            end[i] = begin[i];
+        for( node_type v = t.first_node(); t.is_node( v ); v = t.next_node( v ) ) { 
+            unsigned int& k = end[ t.index(v) ];
+            for( adj_iterator p = t.adj_begin( v ); p != t.adj_end( v ); p = t.adj_next( p, v ) ) { 
+                adj[k] = t.opposite( p, v );
+                rank[k] = (rank_type) t.rank( p );
+                k++;
+            }
+        }
+    }
+
+    // the position of a scan of a compressed list
+    struct varint_cursor { 
+        varint_reader in;
+        unsigned int k;         // index of the next entry
+        unsigned int left;      // entries not yet scanned
+        unsigned int id;        // the last opposite node
+        unsigned int rank;      // the last rank
+    };
+
+    
+    inline unsigned int zigzag( int d ) { return ( (unsigned int) d << 1 ) ^ (unsigned int) ( d >> 31 ); }
+
+    inline int unzigzag( unsigned int z ) { return (int) ( z >> 1 ) ^ -(int) ( z & 1 ); }
+
+    // The adjacency lists compressed with the group varint code. Within 
+    // each rank the entries are sorted by the opposite node, and each 
+    // entry is one value holding the difference to the previous opposite 
+    // node, zigzag encoded, shifted left by two bits. The low bits tell 
+    // whether the rank is that of the previous entry (0), one more (1) 
+    // or given by a second value holding the difference (2), thus runs 
+    // of equal or consecutive ranks cost no extra bytes. Lists with 
+    // near-contiguous opposite nodes take close to one byte per entry. 
+    //
+    // Dropping an entry may lengthen the difference of the next one, thus 
+    // pruning cannot always rewrite a list in place. A bit per entry marks 
+    // the pruned entries, which are decoded and skipped by the scans. When 
+    // a pass drops entries of a list, the ones which survive are encoded 
+    // again in a scratch buffer, and if they fit in the bytes of the list, 
+    // which is the common case, they replace it and its marks are cleared. 
+    // A list without entries left is not decoded at all.
+    template<int Bytes>
+    class varint_adjacency
+    { 
+        public:
+            typedef typename narrow_rank<Bytes>::type stamp_type;
+            typedef varint_cursor cursor_type;
+
+            template<class Traits> 
+            varint_adjacency( const Traits& t, Workspace& ws, int n, const SolveOptions& );
+
+            void first( unsigned int v, cursor_type& c ) const { 
+                c.in.start( begin[v] );
+                c.k = entry[v];
+                c.left = live[v] ? stored[v] : 0;
+                c.id = c.rank = 0;
+            }
+
+            bool next( unsigned int, cursor_type& c, unsigned int& w, int& r ) const { 
+                while( c.left > 0 ) { 
+                    c.left--;
+                    unsigned int x = c.in.read( bytes );
+                    c.rank += x & 1;
+                    if ( x & 2 ) 
+                        c.rank += c.in.read( bytes );
+                    c.id += unzigzag( x >> 2 );
+                    unsigned int k = c.k++;
+                    if ( ( pruned[ k >> 5 ] >> ( k & 31 ) ) & 1u ) 
+                        continue;
+                    w = c.id;
+                    r = c.rank;
+                    return true;
+                }
+                return false;
+            }
+
+            template<class Keep> 
+            void filter( unsigned int v, Keep& keep ) { 
+                cursor_type c;
+                unsigned int w, before = live[v];
+                int r;
+
+                first( v, c );
+                while( next( v, c, w, r ) ) 
+                    if ( ! keep( w, r ) ) { 
+                        unsigned int k = c.k - 1;
+                        pruned[ k >> 5 ] |= 1u << ( k & 31 );
+                        live[v]--;
+                    }
+                if ( live[v] == before || live[v] == 0 ) 
+                    return;
+
+                // the scratch buffer holds the longest list, bound by this one
+                varint_writer out;
+                unsigned int id = 0, rank = 0;
+                out.start( 0, begin[v+1] - begin[v] );
+                first( v, c );
+                while( next( v, c, w, r ) && ! out.overflow() ) { 
+                    encode( out, scratch, w - id, r - rank );
+                    id = w;
+                    rank = r;
+                }
+                out.flush( scratch );
+                if ( ! out.overflow() ) { 
+                    memcpy( bytes + begin[v], scratch, out.position() );
+                    for( unsigned int k = entry[v]; k < entry[v] + stored[v]; ++k ) 
+                        pruned[ k >> 5 ] &= ~( 1u << ( k & 31 ) );
+                    stored[v] = live[v];
+                }
+            }
+
+            void start_filter() {}
+            void finish_filter() {}
+            void transferred( size_t& read, size_t& written ) { read = written = 0; }
+
+            // the differences of smaller node indices leave room for the 
+            // two low bits, larger instances are left to plain_adjacency
+            static int MaxNodes() { return 1 << 29; }
+
+        private:
+            template<class Sink> 
+            static void encode( Sink& out, unsigned char* b, unsigned int d, unsigned int dr ) { 
+                unsigned int tag = dr == 0 ? 0 : ( dr == 1 ? 1 : 2 );
+                write( out, b, ( zigzag( (int) d ) << 2 ) | tag );
+                if ( tag == 2 ) 
+                    write( out, b, dr );
+            }
+
+            static void write( varint_writer& out, unsigned char* b, unsigned int x ) { out.write( b, x ); }
+            static void write( varint_counter& out, unsigned char*, unsigned int x ) { out.write( x ); }
+
+            template<class Traits, class Sink> 
+            void encode_list( const Traits& t, typename Traits::node_type v, Sink& out, 
+                    std::vector<unsigned int>& ids );
+
+            size_t* begin;          // first byte of each list, n + 1 entries
+            unsigned int* entry;    // index of the first entry of each list
+            unsigned int* stored;   // number of entries in the list
+            unsigned int* live;     // number of entries which are not pruned
+            unsigned int* pruned;   // a bit per entry
+            unsigned char* bytes;
+            unsigned char* scratch; // as large as the longest list
+    };
+
+    template<int Bytes> template<class Traits, class Sink> 
+    void varint_adjacency<Bytes>::encode_list( const Traits& t, typename Traits::node_type v, 
+            Sink& out, std::vector<unsigned int>& ids ) 
+    { 
+        typedef typename Traits::adj_iterator adj_iterator;
+        unsigned int id = 0, rank = 0;
+
+        for( adj_iterator p = t.adj_begin( v ); p != t.adj_end( v ); ) { 
+            // the entries of one rank, by opposite node
+            adj_iterator q = p;
+            unsigned int r = t.rank( p );
+            ids.clear();
+            for( ; q != t.adj_end( v ) && (unsigned int) t.rank( q ) == r; q = t.adj_next( q, v ) ) 
+                ids.push_back( t.opposite( q, v ) );
+            std::sort( ids.begin(), ids.end() );
+
+            for( unsigned int i = 0; i < ids.size(); ++i ) { 
+                encode( out, bytes, ids[i] - id, r - rank );
+                id = ids[i];
+                rank = r;
+            }
+            p = q;
+        }
+    }
+
+    template<int Bytes> template<class Traits> 
+    varint_adjacency<Bytes>::varint_adjacency( const Traits& t, Workspace& ws, int n, 
+            const SolveOptions& ) 
+        : begin( workspace_array<size_t>( ws, n + 1 ) ),
+          entry( workspace_array<unsigned int>( ws, n ) ),
+          stored( workspace_array<unsigned int>( ws, n ) ),
+          live( workspace_array<unsigned int>( ws, n ) ),
+          pruned( workspace_array<unsigned int>( ws, 2 * t.number_of_edges() / 32 + 1 ) ),
+          bytes( 0 ), scratch( 0 )
+    {
+        typedef typename Traits::node_type node_type;
+        std::vector<unsigned int> ids;
+
+        memset( pruned, 0, ( 2 * t.number_of_edges() / 32 + 1 ) * sizeof( unsigned int ) );
+
+        // measure, then encode
+        for( int i = 0; i <= n; ++i ) 
+            begin[i] = 0;
+        for( int i = 0; i < n; ++i ) 
+            stored[i] = 0;
+        for( node_type v = t.first_node(); t.is_node( v ); v = t.next_node( v ) ) { 
+            varint_counter c;
+            encode_list( t, v, c, ids );
+            begin[ t.index(v) ] = c.bytes;
+            stored[ t.index(v) ] = t.degree( v );
+        }
+
+        size_t total = 0, longest = 0;
+        unsigned int k = 0;
+        for( int i = 0; i < n; ++i ) { 
+            size_t len = begin[i];
+            begin[i] = total;
+            total += len;
+            if ( len > longest ) 
+                longest = len;
+            entry[i] = k;
+            k += stored[i];
+            live[i] = stored[i];
+        }
+        begin[n] = total;
+
+        bytes = workspace_array<unsigned char>( ws, total + 3 );
+        scratch = workspace_array<unsigned char>( ws, longest );
+        memset( bytes + total, 0, 3 );
+        for( node_type v = t.first_node(); t.is_node( v ); v = t.next_node( v ) ) { 
+            varint_writer out;
+            out.start( begin[ t.index(v) ] );
+            encode_list( t, v, out, ids );
+            out.flush( bytes );
+        }
+    }
+
+    // A scratch file, written sequentially through a buffer and then mapped 
+    // in memory read-only. The file is unlinked as soon as it is created, 
+    // so it is removed by the system when closed, even by a crash.
+    class scratch_file
+    { 
+        public:
+            scratch_file() : fd( -1 ), data( 0 ), size( 0 ) {}
+            ~scratch_file() { close(); }
+
+            void create( const char* directory );
+
+            void append( const unsigned char* p, size_t n ) { 
+                if ( buffer.size() + n > buffer.capacity() ) 
+                    flush();
+                buffer.insert( buffer.end(), p, p + n );
+                size += n;
+            }
+
+            // the contents, nil if the file is empty
+            const unsigned char* map();
+
+            void close();
+
+        private:
+            scratch_file( const scratch_file& );
+            scratch_file& operator=( const scratch_file& );
+
+            void flush();
+
+            int fd;
+            unsigned char* data;    // the mapping
+            size_t size;            // bytes appended
+            std::vector<unsigned char> buffer;
+    };
+
+    inline void scratch_file::create( const char* directory ) 
+    { 
+        close();
+        if ( directory == 0 ) 
+            directory = getenv( "TMPDIR" );
+        if ( directory == 0 || *directory == '\0' ) 
+            directory = "/tmp";
+
+        std::string path( directory );
+        path += "/mosp.XXXXXX";
+        std::vector<char> name( path.begin(), path.end() );
+        name.push_back( '\0' );
+
+        fd = mkstemp( &name[0] );
+        if ( fd < 0 ) 
+            leda::error_handler( 999, "BI_RANK_MAX_MATCHING_COMPACT: cannot create a scratch file" );
+        unlink( &name[0] );
+        buffer.reserve( 1 << 20 );
+    }
+
+    inline void scratch_file::flush() 
+    { 
+        size_t done = 0;
+        while( done < buffer.size() ) { 
+            ssize_t k = ::write( fd, &buffer[ done ], buffer.size() - done );
+            if ( k < 0 && errno == EINTR ) 
+                continue;
+            if ( k <= 0 ) 
+                leda::error_handler( 999, "BI_RANK_MAX_MATCHING_COMPACT: cannot write a scratch file" );
+            done += k;
+        }
+        buffer.clear();
+    }
+
+    inline const unsigned char* scratch_file::map() 
+    { 
+        flush();
+        std::vector<unsigned char>().swap( buffer );
+        if ( size == 0 ) 
+            return 0;
+
+        void* p = mmap( 0, size, PROT_READ, MAP_SHARED, fd, 0 );
+        if ( p == MAP_FAILED ) 
+            leda::error_handler( 999, "BI_RANK_MAX_MATCHING_COMPACT: cannot map a scratch file" );
+        data = (unsigned char*) p;
+        return data;
+    }
+
+    inline void scratch_file::close() 
+    { 
+        if ( data ) 
+            munmap( data, size );
+        if ( fd >= 0 ) 
+            ::close( fd );
+        fd = -1;
+        data = 0;
+        size = 0;
+        std::vector<unsigned char>().swap( buffer );
+    }
+
+    // The plain lists kept out of core, in a scratch file mapped in memory 
+    // as records of the 32-bit index of the opposite node followed by the 
+    // narrow rank. Only the offsets of the lists stay in the workspace. 
+    // A pruning pass streams the entries which survive to a new file, 
+    // which then replaces the old one, thus each phase maps just the edges 
+    // which may still be used. As the lists are rank sorted, the searches 
+    // of a phase read the entries up to its rank and one more per scan. 
+    // The bytes of the records read and written are counted.
+    template<int Bytes>
+    class mapped_adjacency
+    { 
+        public:
+            typedef typename narrow_rank<Bytes>::type rank_type;
+            typedef rank_type stamp_type;
+            typedef size_t cursor_type;
+
+            template<class Traits> 
+            mapped_adjacency( const Traits& t, Workspace& ws, int n, const SolveOptions& options );
+
+            void first( unsigned int v, cursor_type& c ) const { c = begin[v]; }
+
+            bool next( unsigned int v, cursor_type& c, unsigned int& w, int& r ) const { 
+                if ( c == begin[v+1] ) return false;
+                record( c++, w, r );
+                return true;
+            }
+
+            // the end of the list is still the old start of the next one
+            template<class Keep> 
+            void filter( unsigned int v, Keep& keep ) { 
+                size_t from = begin[v], to = begin[v+1];
+                unsigned int w;
+                int r;
+
+                begin[v] = kept;
+                for( size_t k = from; k < to; ++k ) { 
+                    record( k, w, r );
+                    if ( keep( w, r ) ) { 
+                        files[ 1 - current ].append( data + k * RECORD, RECORD );
+                        kept++;
+                    }
+                }
+            }
+
+            void start_filter() { 
+                files[ 1 - current ].create( directory );
+                kept = 0;
+            }
+
+            void finish_filter() { 
+                begin[n] = kept;
+                files[ current ].close();
+                current = 1 - current;
+                data = files[ current ].map();
+                bytes_written += kept * RECORD;
+            }
+
+            void transferred( size_t& read, size_t& written ) { 
+                read = bytes_read;
+                written = bytes_written;
+                bytes_read = bytes_written = 0;
+            }
+
+        private:
+            enum { RECORD = 4 + Bytes };
+
+            void record( size_t k, unsigned int& w, int& r ) const { 
+                const unsigned char* p = data + k * RECORD;
+                rank_type x;
+                memcpy( &w, p, 4 );
+                memcpy( &x, p + 4, Bytes );
+                r = x;
+                bytes_read += RECORD;
+            }
+
+            int n;
+            const char* directory;
+            size_t* begin;              // first entry of each list, n + 1 entries
+            const unsigned char* data;  // the records of the current file
+            scratch_file files[2];      // the current file and the one written by pruning
+            int current;
+            size_t kept;                // entries written by the current pruning pass
+            mutable size_t bytes_read;
+            size_t bytes_written;
+    };
+
+    template<int Bytes> template<class Traits> 
+    mapped_adjacency<Bytes>::mapped_adjacency( const Traits& t, Workspace& ws, int n, 
+            const SolveOptions& options ) 
+        : n( n ), directory( options.scratchDirectory ), 
+          begin( workspace_array<size_t>( ws, n + 1 ) ),
+          data( 0 ), current( 0 ), kept( 0 ), bytes_read( 0 ), bytes_written( 0 )
+    {
+        typedef typename Traits::node_type node_type;
+        typedef typename Traits::adj_iterator adj_iterator;
+        std::vector<node_type> by_index( n );
+        std::vector<char> exists( n, 0 );
+        unsigned char rec[ RECORD ];
+
+        for( int i = 0; i <= n; ++i ) 
+            begin[i] = 0;
+        for( node_type v = t.first_node(); t.is_node( v ); v = t.next_node( v ) ) { 
+            begin[ t.index(v) + 1 ] = t.degree( v );
+            by_index[ t.index(v) ] = v;
+            exists[ t.index(v) ] = 1;
+        }
+        for( int i = 1; i <= n; ++i ) 
+            begin[i] += begin[i-1];
+
+        // the file is written sequentially, in index order
+        files[ current ].create( directory );
+        for( int i = 0; i < n; ++i ) { 
+            if ( ! exists[i] ) 
+                continue;
+            node_type v = by_index[i];
+            for( adj_iterator p = t.adj_begin( v ); p != t.adj_end( v ); p = t.adj_next( p, v ) ) { 
+                unsigned int w = t.opposite( p, v );
+                rank_type x = (rank_type) t.rank( p );
+                memcpy( rec, &w, 4 );
+                memcpy( rec + 4, &x, Bytes );
+                files[ current ].append( rec, RECORD );
+            }
+        }
+        data = files[ current ].map();
+        bytes_written = begin[n] * RECORD;
+    }
+
+    // The scratch state of a solve, indexed by the index of the nodes and 
+    // living in a workspace, on top of an adjacency representation. With 
+    // the plain lists and R bytes per rank this is 2(4+R) bytes per edge, 
+    // and 28+2R bytes and 3 bits per node, plus 4 bytes per node of A and 
+    // per rank, as counted by BI_RANK_MAX_MATCHING_COMPACT_BYTES. With the 
+    // mapped lists only the node state stays in memory, with 8 more bytes 
+    // per node for the list offsets and the search cursors.
+    template<class Adjacency>
+    struct compact_state { 
+        typedef typename Adjacency::cursor_type cursor_type;
+
+        template<class Traits> 
+        compact_state( const Traits& t, Workspace& ws, const SolveOptions& options );
+
+        int n;                  // size of the index space
+        int nodes;              // number of nodes
+        Adjacency adj;
+        unsigned int* mate;     // NONE if free
+        unsigned int* pred;     // parent in the current search
+        unsigned int* dist;     // level in the current layering
+        cursor_type* cursor;    // next entry scanned by the layered searches
+        unsigned int* queue;    // queue of the searches, stack of the layered searches
+        unsigned int* freeA;    // the free nodes of A, in order
+        int nfree;
+        LabelPlanes labels;
+        EpochStamps<typename Adjacency::stamp_type> layered;    // reached by the current layering
+        EpochStamps<typename Adjacency::stamp_type> visited;    // visited by the current augmenting searches
+    };
+
+    template<class Adjacency> template<class Traits> 
+    compact_state<Adjacency>::compact_state( const Traits& t, Workspace& ws, 
+            const SolveOptions& options ) 
+        : n( t.index_bound() ), 
+          nodes( t.number_of_nodes() ),
+          adj( t, ws, n, options ),
+          mate( workspace_array<unsigned int>( ws, n ) ),
+          pred( workspace_array<unsigned int>( ws, n ) ),
+          dist( workspace_array<unsigned int>( ws, n ) ),
+          cursor( workspace_array<cursor_type>( ws, n ) ),
+          queue( workspace_array<unsigned int>( ws, n ) ),
+          freeA( workspace_array<unsigned int>( ws, t.size_of_A() ) ),
+          nfree( 0 ),
+          labels( ws, n, LABEL_PLANES ), 
+          layered( ws, n ), 
+          visited( ws, n )
+    {
+        typedef typename Traits::node_type node_type;
+
+        for( int i = 0; i < n; ++i ) 
+            mate[i] = NONE;
+        for( node_type v = t.first_node(); t.is_node( v ); v = t.next_node( v ) ) 
+            if ( t.in_A( v ) ) { 
+                labels.set( LABEL_A, t.index(v) );
+                freeA[ nfree++ ] = t.index(v);
+            }
+    }
+
+    // keep the nodes of A which are still free, in order
+    template<class State>
+    void compact_free( State& S )
+    { 
+        int k = 0;
+        for( int i = 0; i < S.nfree; ++i ) 
+            if ( S.mate[ S.freeA[i] ] == NONE ) 
+                S.freeA[k++] = S.freeA[i];
+        S.nfree = k;
+    }
+
+    template<class State>
+    void greedy_heuristic( State& S, int phase )
+    { 
+        typename State::cursor_type c;
+        unsigned int w;
+        int r;
+
+        for( int i = 0; i < S.nfree; ++i ) { 
+            unsigned int v = S.freeA[i];
+            S.adj.first( v, c );
+            while( S.adj.next( v, c, w, r ) && r <= phase ) 
+                if ( S.mate[w] == NONE ) { 
+                    S.mate[v] = w; S.mate[w] = v;
+                    break;
+                }
+        }
+        compact_free( S );
+    }
+
+    // The Hopcroft-Karp layering from the free nodes of A, which ends 
+    // with the level of the first free node of B. Returns false if there 
+    // is no augmenting path.
+    template<class State>
+    bool layer( State& S, int phase )
+    { 
+        typename State::cursor_type c;
+        unsigned int head = 0, tail = 0, last = NONE, w;
+        int r;
+
+        S.layered.next();
+        for( int i = 0; i < S.nfree; ++i ) { 
+            unsigned int v = S.freeA[i];
+            S.layered.mark( v );
+            S.dist[v] = 0;
+            S.queue[ tail++ ] = v;
+        }
+
+        while( head < tail ) { 
+            unsigned int v = S.queue[ head++ ];
+            if ( S.dist[v] >= last ) 
+                break;
+            S.adj.first( v, c );
+            while( S.adj.next( v, c, w, r ) && r <= phase ) { 
+                if ( w == S.mate[v] || S.layered.marked( w ) ) 
+                    continue;
+                S.layered.mark( w );
+                S.dist[w] = S.dist[v] + 1;
+                unsigned int u = S.mate[w];
+                if ( u == NONE ) 
+                    last = S.dist[w];
+                else if ( ! S.layered.marked( u ) ) { 
+                    S.layered.mark( u );
+                    S.dist[u] = S.dist[w] + 1;
+                    S.queue[ tail++ ] = u;
+                }
+            }
+        }
+        return last != NONE;
+    }
+
+    // whether w is on the level following v in the layering
+    template<class State>
+    inline bool next_level( const State& S, unsigned int v, unsigned int w )
+    { 
+        return S.layered.marked( w ) && S.dist[w] == S.dist[v] + 1;
+    }
+
+    // Depth first search for an augmenting path from the free node a along 
+    // the layering, which avoids the nodes visited by the searches of the 
+    // same round. Augments and returns true if one is found.
+    template<class State>
+    bool augment_layered( State& S, unsigned int a, int phase )
+    { 
+        unsigned int* stack = S.queue;
+        unsigned int w;
+        int r, top = 0;
+
+        S.visited.mark( a );
+        S.adj.first( a, S.cursor[a] );
+        stack[0] = a;
+
+        while( top >= 0 ) { 
+            unsigned int v = stack[top];
+            bool descended = false;
+
+            while( S.adj.next( v, S.cursor[v], w, r ) && r <= phase ) { 
+                if ( w == S.mate[v] || S.visited.marked( w ) || ! next_level( S, v, w ) ) 
+                    continue;
+                S.visited.mark( w );
+
+                unsigned int u = S.mate[w];
+                if ( u == NONE ) { 
+                    // augment along the stack
+                    unsigned int x = w;
+                    for( int i = top; i >= 0; --i ) { 
+                        unsigned int y = S.pred[ stack[i] ];
+                        S.mate[ stack[i] ] = x;
+                        S.mate[x] = stack[i];
+                        x = y;
+                    }
+                    return true;
+                }
+
+                if ( S.visited.marked( u ) || ! next_level( S, w, u ) ) 
+                    continue;
+                S.visited.mark( u );
+                S.pred[u] = w;
+                S.adj.first( u, S.cursor[u] );
+                stack[ ++top ] = u;
+                descended = true;
+                break;
+            }
+
+            if ( ! descended ) 
+                top--;
+        }
+        return false;
+    }
+
+    // Find a single augmenting path by a breadth first search started 
+    // from all free nodes of A at once and augment along it. Returns 
+    // false if the matching is maximum.
+    template<class State>
+    bool augment_single_path( State& S, int phase )
+    { 
+        typename State::cursor_type c;
+        unsigned int head = 0, tail = 0, w;
+        int r;
+
+        S.visited.next();
+        for( int i = 0; i < S.nfree; ++i ) { 
+            unsigned int v = S.freeA[i];
+            S.visited.mark( v );
+            S.pred[v] = NONE;
+            S.queue[ tail++ ] = v;
+        }
+
+        while( head < tail ) { 
+            unsigned int v = S.queue[ head++ ];
+            S.adj.first( v, c );
+            while( S.adj.next( v, c, w, r ) && r <= phase ) { 
+                if ( w == S.mate[v] || S.visited.marked( w ) ) 
+                    continue;
+                S.visited.mark( w );
+                S.pred[w] = v;
+
+                unsigned int u = S.mate[w];
+                if ( u == NONE ) { 
+                    // augment, the path alternates starting with a free edge
+                    unsigned int x = w;
+                    u = v;
+                    for( ;; ) { 
+                        unsigned int y = S.pred[u];
+                        S.mate[u] = x;
+                        S.mate[x] = u;
+                        if ( y == NONE ) 
+                            break;
+                        x = y;
+                        u = S.pred[y];
+                    }
+                    compact_free( S );
+                    return true;
+                }
+
+                if ( S.visited.marked( u ) ) 
+                    continue;
+                S.visited.mark( u );
+                S.pred[u] = w;
+                S.queue[ tail++ ] = u;
+            }
+        }
+        return false;
+    }
+
+    // Augment the matching to a maximum one in the subgraph of edges with 
+    // rank at most phase, see max_card_bipartite_matching_HK() of the 
+    // combinatorial engine for the use of bound.
+    template<class State>
+    void max_card_matching( State& S, int phase, int bound, 
+            int& rounds, int& augmentations, int& searches )
+    { 
+        if ( bound > S.nfree ) 
+            bound = S.nfree;
+        const int few = (int) ( 2.0 * sqrt( (double) S.nodes ) );
+
+        while( bound > few ) { 
+            if ( ! layer( S, phase ) ) 
+                return;
+
+            // augment on disjoint shortest paths
+            S.visited.next();
+            int found = 0;
+            for( int i = 0; i < S.nfree; ++i ) 
+                if ( augment_layered( S, S.freeA[i], phase ) ) 
+                    found++;
+            compact_free( S );
+
+            augmentations += found;
+            bound -= found;
+            rounds++;
+        }
+
+        // few augmentations remain, find them one at a time
+        while( bound > 0 ) { 
+            searches++;
+            if ( ! augment_single_path( S, phase ) ) 
+                break;
+            augmentations++;
+            bound--;
+        }
+    }
+
+    // label the even, odd and unreached nodes by an alternating breadth 
+    // first search from the free nodes, among the edges of rank at most rmax
+    template<class State>
+    void partition( State& S, int rmax )
+    { 
+        typename State::cursor_type c;
+        unsigned int head = 0, tail = 0, w;
+        int r;
+
+        for( int i = 0; i < S.n; ++i ) 
+            if ( S.mate[i] == NONE ) { 
+                S.labels.set( LABEL_REACHED, i );
+                S.queue[ tail++ ] = i;
+            }
+
+        while( head < tail ) { 
+            unsigned int v = S.queue[ head++ ];
+            if ( S.labels.test( LABEL_ODD, v ) ) { 
+                unsigned int u = S.mate[v];
+                if ( u != NONE && ! S.labels.test( LABEL_REACHED, u ) ) { 
+                    S.labels.set( LABEL_REACHED, u );
+                    S.queue[ tail++ ] = u;
+                }
+                continue;
+            }
+            S.adj.first( v, c );
+            while( S.adj.next( v, c, w, r ) && r <= rmax ) { 
+                if ( w == S.mate[v] || S.labels.test( LABEL_REACHED, w ) ) 
+                    continue;
+                S.labels.set( LABEL_REACHED, w );
+                S.labels.set( LABEL_ODD, w );
+                S.queue[ tail++ ] = w;
+            }
+        }
+    }
+
+    // decides which entries of the list of v survive pruning
+    struct prune_rule { 
+        prune_rule( const LabelPlanes& l, int p, int* s, int& t ) 
+            : labels( l ), phase( p ), edge_set_size( s ), 
+              total_edge_set_size( t ), pruned( 0 ) 
+        {
+        }
+
+        void Node( unsigned int v ) { 
+            v_reached = labels.test( LABEL_REACHED, v );
+            v_is_odd = labels.test( LABEL_ODD, v );
+            in_A = labels.test( LABEL_A, v );
+        }
+
+        bool operator()( unsigned int w, int r ) { 
+            bool w_reached = labels.test( LABEL_REACHED, w );
+            bool w_is_odd = labels.test( LABEL_ODD, w );
+            bool drop;
+
+            if ( r <= phase-1 ) 
+                drop = ( v_is_odd && ( ! w_reached || w_is_odd ) ) || 
+                       ( w_is_odd && ( ! v_reached || v_is_odd ) );
+            else 
+                drop = ! v_reached || ! w_reached || v_is_odd || w_is_odd;
+
+            if ( drop && in_A ) { 
+                edge_set_size[r]--;
+                if ( r > phase-1 ) 
+                    total_edge_set_size--;
+                pruned++;
+            }
+            return ! drop;
+        }
+
+        const LabelPlanes& labels;
+        int phase;
+        int* edge_set_size;
+        int& total_edge_set_size;
+        int pruned;
+        bool v_reached, v_is_odd, in_A;
+    };
+
+    // Remove the edges which cannot belong to a rank-maximal matching, 
+    // the odd-odd and odd-unreached edges of rank less than phase and the 
+    // edges of larger rank incident to an odd or unreached node. Both 
+    // entries of an edge are removed, the edges are counted at their 
+    // endpoint in A. Clears the labels of the partition.
+    template<class State>
+    int prune_edges( State& S, int phase, int* edge_set_size, int& total_edge_set_size )
+    { 
+        prune_rule rule( S.labels, phase, edge_set_size, total_edge_set_size );
+        S.adj.start_filter();
+        for( int v = 0; v < S.n; ++v ) { 
+            rule.Node( v );
+            S.adj.filter( v, rule );
+        }
+        S.adj.finish_filter();
+        S.labels.clear( LABEL_REACHED );
+        S.labels.clear( LABEL_ODD );
+        return rule.pruned;
+    }
+
+    // The engine, computing a rank-maximal matching of the graph presented 
+    // by the adapter t and passing the mates of the nodes to the sink, 
+    // which is not called if the graph has no edges.
+    template<class Adjacency, class Traits, class Sink>
+    void compact_rank_max_matching( const Traits& t, const SolveOptions& options, Sink& sink )
+    { 
+        typedef typename Traits::node_type node_type;
+
+        SolveStats* stats = options.stats;
+        int min_rank = t.min_rank(), max_rank = t.max_rank();
+
+        double Tstart = 0.0, Ttemp = 0.0;
+        if ( stats ) { 
+            stats->Clear();
+            Tstart = SolveStats::WallClock();
+        }
+
+        if ( t.number_of_edges() == 0 ) { 
+            if ( stats ) 
+                stats->totalTime = SolveStats::WallClock() - Tstart;
+            return;
+        }
+
+        Workspace local;
+        Workspace& ws = options.workspace ? *options.workspace : local;
+        ws.Release();
+        compact_state<Adjacency> S( t, ws, options );
+
+        int* edge_set_size = workspace_array<int>( ws, max_rank + 1 );
+        int total_edge_set_size = 0;
+        for( int r = 0; r <= max_rank; ++r ) { 
+            edge_set_size[ r ] = t.rank_size( r );
+            if( r > min_rank ) 
+                total_edge_set_size += edge_set_size[ r ];
+        }
+
+        if ( stats ) { 
+            stats->stateBytes = ws.Used();
+            Ttemp = SolveStats::WallClock();
+        }
+
+        int phase = min_rank;
+        int rounds = 0, augmentations = 0, searches = 0;
+        greedy_heuristic( S, phase );
+        max_card_matching( S, phase, S.nfree, rounds, augmentations, searches );
+
+        if ( stats ) { 
+            PhaseStats& ps = stats->NewPhase( phase );
+            ps.edgesAdded = edge_set_size[ phase ];
+            ps.hkRounds = rounds;
+            ps.singlePathSearches = searches;
+            ps.augmentations = augmentations;
+            ps.matchingTime = SolveStats::WallClock() - Ttemp;
+            S.adj.transferred( ps.bytesRead, ps.bytesWritten );
+        }
+
+        phase++;
+        while( phase <= max_rank ) { 
+
+            if ( total_edge_set_size == 0 ) break;
+            if ( edge_set_size[ phase ] == 0 ) {  
+                phase++;
+                continue;
+            }
+
+            PhaseStats* ps = 0;
+            if ( stats ) { 
+                ps = &stats->NewPhase( phase );
+                Ttemp = SolveStats::WallClock();
+            }
+
+            partition( S, phase - 1 );
+
+            if ( ps ) { 
+                for( node_type v = t.first_node(); t.is_node( v ); v = t.next_node( v ) ) { 
+                    if ( ! S.labels.test( LABEL_REACHED, t.index(v) ) ) ps->unreached++;
+                    else if ( S.labels.test( LABEL_ODD, t.index(v) ) ) ps->odd++;
+                    else ps->even++;
+                }
+                ps->partitionTime = SolveStats::WallClock() - Ttemp;
+                Ttemp += ps->partitionTime;
+            }
+
+            int pruned = prune_edges( S, phase, edge_set_size, total_edge_set_size );
+
+            if ( ps ) { 
+                ps->edgesPruned = pruned;
+                ps->edgesAdded = edge_set_size[ phase ];
+                ps->pruneTime = SolveStats::WallClock() - Ttemp;
+                Ttemp += ps->pruneTime;
+            }
+
+            // each augmenting path uses one of the new edges
+            rounds = augmentations = searches = 0;
+            max_card_matching( S, phase, edge_set_size[ phase ], 
+                    rounds, augmentations, searches );
+
+            if ( ps ) { 
+                ps->hkRounds = rounds;
+                ps->singlePathSearches = searches;
+                ps->augmentations = augmentations;
+                ps->matchingTime = SolveStats::WallClock() - Ttemp;
+                S.adj.transferred( ps->bytesRead, ps->bytesWritten );
+            }
+
+            phase++;
+            total_edge_set_size -= edge_set_size[ phase - 1 ];
+        }
+
+        sink( t, S.mate );
+
+        if ( stats ) 
+            stats->totalTime = SolveStats::WallClock() - Tstart;
+    }
+
+    // bytes of each rank, as chosen by BI_RANK_MAX_MATCHING_COMPACT
+    inline int rank_bytes( int max_rank ) 
+    { 
+        if ( max_rank <= narrow_rank<1>::limit() ) return 1;
+        if ( max_rank <= narrow_rank<2>::limit() ) return 2;
+        return 4;
+    }
+
+    // the engine on the narrowest ranks and stamps holding the maximum rank
+    template<template<int> class Adjacency, class Traits, class Sink>
+    void compact_rank_max_matching_by_width( const Traits& t, const SolveOptions& options, 
+            Sink& sink )
+    { 
+        switch( rank_bytes( t.max_rank() ) ) 
+        { 
+            case 1: compact_rank_max_matching< Adjacency<1> >( t, options, sink ); break;
+            case 2: compact_rank_max_matching< Adjacency<2> >( t, options, sink ); break;
+            default: compact_rank_max_matching< Adjacency<4> >( t, options, sink ); break;
+        }
+    }
+
+    // the engine with the requested encoding of the adjacency lists
+    template<class Traits, class Sink>
+    void compact_rank_max_matching( const Traits& t, const SolveOptions& options, 
+            AdjacencyEncoding encoding, Sink& sink )
+    { 
+        if ( encoding == ADJACENCY_MAPPED ) 
+            compact_rank_max_matching_by_width<mapped_adjacency>( t, options, sink );
+        else if ( encoding == ADJACENCY_VARINT && 
+                t.index_bound() <= varint_adjacency<1>::MaxNodes() ) 
+            compact_rank_max_matching_by_width<varint_adjacency>( t, options, sink );
+        else 
+            compact_rank_max_matching_by_width<plain_adjacency>( t, options, sink );
+    }
+
+    inline void append_edge( leda::list<leda::edge>& M, leda::edge e ) { M.append( e ); }
+
+    template<class Edge> 
+    inline void append_edge( std::vector<Edge>& M, const Edge& e ) { M.push_back( e ); }
+
+    // a sink appending the matched edges, found in the adjacency lists of 
+    // the graph, to a list or a vector
+    template<class Edges>
+    struct edge_sink 
+    { 
+        edge_sink( Edges& M ) : M( M ) {}
+
+        template<class Traits>
+        void operator()( const Traits& t, const unsigned int* mate ) 
+        { 
+            typedef typename Traits::node_type node_type;
+            typedef typename Traits::adj_iterator adj_iterator;
+
+            for( node_type v = t.first_node(); t.is_node( v ); v = t.next_node( v ) ) { 
+                if ( ! t.in_A( v ) ) 
+                    continue;
+                unsigned int w = mate[ t.index(v) ];
+                if ( w == NONE ) 
+                    continue;
+                for( adj_iterator p = t.adj_begin( v ); p != t.adj_end( v ); p = t.adj_next( p, v ) ) 
+                    if ( t.opposite( p, v ) == w ) { 
+                        append_edge( M, t.edge( p ) );
+                        break;
+                    }
+            }
+        }
+
+        Edges& M;
+    };
+
+    // a sink copying the mates to a mate array, NONE becoming NO_MATE
+    struct mate_sink 
+    { 
+        mate_sink( int32_t* mate ) : mate( mate ), matched( 0 ) {}
+
+        template<class Traits>
+        void operator()( const Traits& t, const unsigned int* m ) 
+        { 
+            int n = t.index_bound();
+            for( int i = 0; i < n; ++i ) { 
+                mate[i] = (int32_t) m[i];
+                if ( m[i] != NONE ) 
+                    matched++;
+            }
+            matched /= 2;
+        }
+
+        int32_t* mate;
+        int matched;
+    };
+
+    } // end of namespace compact
+
+/*! \brief Compute a rank-maximal matching of any graph type in compact state.
+ *
+ * The engine of BI_RANK_MAX_MATCHING_COMPACT, reading the graph through 
+ * graph_traits<Graph> instead of an Instance. It is instantiated for the 
+ * graph type, thus the lists are copied into the compact state without a 
+ * copy of the graph and without a virtual call per node or edge. 
+ * Adapters exist for an Instance, a leda::GRAPH whose edge information 
+ * is the rank and a CsrGraph, see graph_traits.
+ *  \param G The graph
+ *  \param M The handles of the matched edges are appended here.
+ *  \param options Statistics and scratch memory of the solve, see SolveOptions.
+ *  \param encoding The representation of the adjacency lists.
+ *  \pre G must satisfy the preconditions of its adapter.
+ *  \ingroup rankmax
+ */
+template<class Graph>
+void BI_RANK_MAX_MATCHING_COMPACT_T( const Graph& G, 
+        std::vector<typename graph_traits<Graph>::edge_type>& M, 
+        const SolveOptions& options = SolveOptions(), 
+        AdjacencyEncoding encoding = ADJACENCY_PLAIN )
+{
+    typedef typename graph_traits<Graph>::edge_type edge_type;
+    graph_traits<Graph> t( G );
+    compact::edge_sink< std::vector<edge_type> > sink( M );
+    compact::compact_rank_max_matching( t, options, encoding, sink );
+}
+
+/*! \brief Compute a rank-maximal matching of any graph type in compact state as a mate array.
+ *
+ * As above, with the mates of the solver state copied to a mate array, 
+ * see mates.h. The entries are indexed by the node indices of the adapter.
+ *  \param G The graph
+ *  \param mate An array of graph_traits<Graph>(G).index_bound() entries.
+ *  \param options Statistics and scratch memory of the solve, see SolveOptions.
+ *  \param encoding The representation of the adjacency lists.
+ *  \return The number of matched edges.
+ *  \pre G must satisfy the preconditions of its adapter.
+ *  \ingroup rankmax
+ */
+template<class Graph>
+int BI_RANK_MAX_MATCHING_COMPACT_T( const Graph& G, int32_t* mate, 
+        const SolveOptions& options, 
+        AdjacencyEncoding encoding = ADJACENCY_PLAIN )
+{
+    graph_traits<Graph> t( G );
+    for( int i = 0; i < t.index_bound(); ++i ) 
+        mate[i] = NO_MATE;
+    compact::mate_sink sink( mate );
+    compact::compact_rank_max_matching( t, options, encoding, sink );
+    return sink.matched;
+}
+
+} // end of namespace
+
+#endif  // LEP_RANK_MAX_MATCHING_COMPACT_T_H
+
+/* ex: set ts=4 sw=4 sts=4 et: */
@@ -0,0 +1,238 @@
+//
+// This program can be freely used in an academic environment
+// ONLY for research purposes, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    an acknowledgment in the product documentation is required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// Any other use is strictly prohibited by the author, without an explicit
+// permission.
+//
+// Note that this program uses the LEDA library, which is NOT free. For more
+// details visit Algorithmic Solutions at http://www.algorithmic-solutions.com/
+//
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+// ! Any commercial use of this software is strictly !
+// ! prohibited without explicit permission by the   !
+// ! author.                                         !
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// Copyright (C) 2004-2010 Dimitrios Michail <dimitrios.michail@gmail.com>
+//
+
+/*! \file compact_state.h
+ *  \brief Narrow arrays and codes of the solver state of the compact engine.
+ *
+ *  Used by RANK_MAX_MATCHING_COMPACT_T.h, not meant to be included directly.
+ */
+
+#ifndef LEP_COMPACT_STATE_H
+#define LEP_COMPACT_STATE_H
+
+#include <LEP/mosp/config.h>
+#include <LEP/mosp/workspace.h>
+#include <string.h>
+
+namespace mosp
+{
+
+    // Storage of the ranks in the compact engine. The width is picked 
+    // by the maximum rank of the instance, the engine is instantiated 
+    // once per width.
+    template<int Bytes> struct narrow_rank;
+
+    template<> struct narrow_rank<1> { 
+        typedef unsigned char type;
+        static int limit() { return 0xff; }
+    };
+
+    template<> struct narrow_rank<2> { 
+        typedef unsigned short type;
+        static int limit() { return 0xffff; }
+    };
+
+    template<> struct narrow_rank<4> { 
+        typedef unsigned int type;
+        static int limit() { return 0x7fffffff; }
+    };
+
+    // An uninitialized array of plain values living in a workspace.
+    template<class T> 
+    inline T* workspace_array( Workspace& ws, size_t n ) 
+    { 
+        return static_cast<T*>( ws.Allocate( ( n > 0 ? n : 1 ) * sizeof( T ) ) );
+    }
+
+    // Boolean labels of the nodes 0..n-1, one bit plane per label, 
+    // which live in a workspace.
+    class LabelPlanes
+    { 
+        public:
+            LabelPlanes( Workspace& ws, int n, int planes ) 
+                : words( n / 32 + 1 ), 
+                  bits( workspace_array<unsigned int>( ws, (size_t) words * planes ) )
+            { 
+                memset( bits, 0, (size_t) words * planes * sizeof( unsigned int ) );
+            }
+
+            bool test( int p, unsigned int i ) const { 
+                return ( bits[ p * words + ( i >> 5 ) ] >> ( i & 31 ) ) & 1u;
+            }
+
+            void set( int p, unsigned int i ) { 
+                bits[ p * words + ( i >> 5 ) ] |= 1u << ( i & 31 );
+            }
+
+            void clear( int p ) { 
+                memset( bits + p * words, 0, words * sizeof( unsigned int ) );
+            }
+
+            static size_t Bytes( int n, int planes ) { 
+                return (size_t) ( n / 32 + 1 ) * planes * sizeof( unsigned int );
+            }
+
+        private:
+            int words;
+            unsigned int* bits;
+    };
+
+    // Visited marks of repeated searches over the nodes 0..n-1. Each 
+    // search is an epoch and marks a node by storing the epoch, thus 
+    // starting a search does not touch the nodes. When the epoch counter 
+    // wraps around all stamps are cleared, once every 2^bits - 1 searches, 
+    // which keeps narrow stamps cheap.
+    template<class T>
+    class EpochStamps
+    { 
+        public:
+            EpochStamps( Workspace& ws, int n ) 
+                : size( n ), epoch( 0 ), stamp( workspace_array<T>( ws, n ) )
+            { 
+                memset( stamp, 0, (size_t) n * sizeof( T ) );
+            }
+
+            void next() { 
+                if ( ++epoch == 0 ) { 
+                    memset( stamp, 0, (size_t) size * sizeof( T ) );
+                    epoch = 1;
+                }
+            }
+
+            bool marked( unsigned int i ) const { return stamp[i] == epoch; }
+
+            void mark( unsigned int i ) { stamp[i] = epoch; }
+
+        private:
+            int size;
+            T epoch;
+            T* stamp;
+    };
+
+    // Group varint coding of unsigned 32-bit values. Four values share a 
+    // control byte holding their lengths in bytes minus one, two bits per 
+    // value, and are followed by their bytes, least significant first. 
+    // Decoding takes the length from the control byte and loads each value 
+    // with four byte loads and a mask, without a branch per byte, which is 
+    // also the layout decoded by the SIMD shuffle decoders. The buffer must 
+    // be followed by three bytes of padding.
+    inline unsigned int varint_bytes( unsigned int x ) 
+    { 
+        return 1 + ( x > 0xffu ) + ( x > 0xffffu ) + ( x > 0xffffffu );
+    }
+
+    // the size of a sequence of values
+    struct varint_counter { 
+        varint_counter() : bytes( 0 ), n( 0 ) {}
+
+        void write( unsigned int x ) { 
+            if ( ( n++ & 3 ) == 0 ) bytes++;
+            bytes += varint_bytes( x );
+        }
+
+        size_t bytes;
+        unsigned int n;
+    };
+
+    // The control byte is kept shifted with a stop bit above it, which is 
+    // all that is left once the lengths of its group are used up.
+    class varint_reader
+    { 
+        public:
+            void start( size_t p ) { pos = p; ctrl = 1; }
+
+            unsigned int read( const unsigned char* b ) { 
+                if ( ctrl == 1 ) 
+                    ctrl = b[ pos++ ] | 0x100u;
+                unsigned int len = ctrl & 3;
+                ctrl >>= 2;
+                const unsigned char* p = b + pos;
+                unsigned int x = p[0] | ( p[1] << 8 ) | ( p[2] << 16 ) | 
+                    ( (unsigned int) p[3] << 24 );
+                pos += len + 1;
+                return x & ( 0xffffffffu >> ( 8 * ( 3 - len ) ) );
+            }
+
+        private:
+            size_t pos;
+            unsigned int ctrl;
+    };
+
+    // Writes groups of four values, the last group of a sequence is 
+    // completed by flush(). A group which would end past the limit given 
+    // to start() is not written, and neither is anything after it.
+    class varint_writer
+    { 
+        public:
+            void start( size_t p, size_t l = (size_t) -1 ) { pos = p; limit = l; n = 0; full = false; }
+
+            size_t position() const { return pos; }
+            bool overflow() const { return full; }
+
+            void write( unsigned char* b, unsigned int x ) { 
+                value[ n++ ] = x;
+                if ( n == 4 ) flush( b );
+            }
+
+            void flush( unsigned char* b ) { 
+                if ( n == 0 ) return;
+                size_t size = 1;
+                for( unsigned int i = 0; i < n; ++i ) 
+                    size += varint_bytes( value[i] );
+                if ( full || size > limit - pos ) { 
+                    full = true;
+                    n = 0;
+                    return;
+                }
+                size_t c = pos++;
+                unsigned int ctrl = 0;
+                for( unsigned int i = 0; i < n; ++i ) { 
+                    unsigned int len = varint_bytes( value[i] );
+                    ctrl |= ( len - 1 ) << ( 2 * i );
+                    for( unsigned int j = 0; j < len; ++j ) 
+                        b[ pos++ ] = (unsigned char) ( value[i] >> ( 8 * j ) );
+                }
+                b[c] = (unsigned char) ctrl;
+                n = 0;
+            }
+
+        private:
+            size_t pos;
+            size_t limit;
+            unsigned int n;
+            unsigned int value[4];
+            bool full;
+    };
+
+}
+
+#endif  // LEP_COMPACT_STATE_H
+
+/* ex: set ts=4 sw=4 sts=4 et: */
@@ -78,6 +78,7 @@ int main( int argc, char* argv[] ) {
 #define LEP_GENERATOR_H
 
 #include <LEP/mosp/config.h>
+#include <LEP/mosp/sampling.h>
 #include <set>
 #include <list>
 #include <vector>
@@ -157,9 +158,10 @@ namespace mosp
             int seedUsed;
             leda::random_source randomSource;  // random source
             leda::random_source randomSourceI; // random source in integer mode
+            RandomSampler sampler;             // sampling on top of randomSource
 
-            std::map<int, leda::node> ApplicantToNode;
-            std::map<int, leda::node> PostToNode;
+            std::vector<leda::node> ApplicantToNode;
+            std::vector<leda::node> PostToNode;
 
             void InitializeGraph( leda::graph& G,
                     leda::list<leda::node>& A, 
@@ -242,9 +244,6 @@ namespace mosp
             // probability of an edge beeing there
             const double EdgeProbability;
             const double Lambda;
-
-            // private implementation
-            bool notIncreaseRank( int j );
     };
 
     /*! \brief An fixed size "exponential" instance generator. 
@@ -328,11 +327,11 @@ namespace mosp
             const double Lambda;
 
             // private implementation
-            typedef std::set<int> Cluster;
-            typedef std::list< Cluster > Clustering;
-
-            Clustering PartitionPosts( int n );
-            Clustering::const_iterator ChooseCluster( const Clustering& c );
+            //
+            // clusters are ranges of consecutive posts, cluster i 
+            // consists of posts clusterStart[i] up to clusterStart[i+1]-1
+            void PartitionPosts( int n, std::vector<int>& clusterStart );
+            int ChooseCluster( int numClusters );
 
             // private implementation
             bool notIncreaseRank( int j );
@@ -435,9 +434,6 @@ namespace mosp
 
             // fixed posts capacity
             int Capacity;
-
-            // get a random subset from the set {0,1,...,n-1}
-            void GetRandomSubset( int n, int k, leda::array<int>& a );   
     };
 
 
@@ -555,6 +551,112 @@ namespace mosp
             const double Lambda;
     };
 
+
+    /*! \brief A skewed instance generator.
+     *
+     * In many real-world assignment situations a few posts are extremely 
+     * popular and appear among the top choices of almost every applicant,
+     * while most posts are only mentioned by a few applicants. Moreover, 
+     * most applicants submit short preference lists but a few submit very 
+     * long ones. Both effects make the matching algorithms much harder, since 
+     * the applicants compete for the same few posts in every rank.
+     *
+     * We model such instances based on the following parameters:
+     *     - number of applicants \f$n\f$ and number of posts \f$m\f$,
+     *     - a skew parameter \f$s \ge 0\f$ for the popularity of the posts,
+     *     - a tie probability \f$t\f$,
+     *     - a minimum and maximum length \f$\ell_{min}\f$ and \f$\ell_{max}\f$ 
+     *       of the preference lists and an exponent \f$\alpha \ge 0\f$ for their 
+     *       distribution, and
+     *     - the capacity \f$c\f$ of each post.
+     *
+     * Post \f$p_j\f$ has popularity proportional to \f$1/j^s\f$ (Zipf's law).
+     * Each applicant first chooses the length \f$\ell\f$ of its preference list
+     * with probability proportional to \f$1/\ell^\alpha\f$, 
+     * \f$\ell_{min} \le \ell \le \ell_{max}\f$. Then it draws \f$\ell\f$ 
+     * distinct posts, one after the other, each with probability proportional to its
+     * popularity. The posts are ranked in the order in which they were drawn, thus
+     * popular posts are highly likely to appear at the top of the list. 
+     * Finally, each entry of the list is tied with its predecessor with probability 
+     * \f$t\f$.
+     *
+     * Both distributions are sampled with the alias method, thus the running time is 
+     * linear in the number of edges of the instance.
+     *
+     *  \ingroup generator
+     */
+    class ZipfInstanceGenerator : public StructuredInstanceGenerator
+    {
+        public:
+            /*! \brief Create a new generator
+             *
+             *  \param apps Number of applicants \f$n\f$
+             *  \param posts Number of posts \f$m\f$
+             *  \param skew Skew of the post popularity \f$s\f$
+             *  \param tie Tie probability \f$t\f$
+             *  \param minLength Minimum length of a preference list \f$\ell_{min}\f$
+             *  \param maxLength Maximum length of a preference list \f$\ell_{max}\f$
+             *  \param alpha Exponent of the list length distribution \f$\alpha\f$
+             *  \param capacity Capacity of each post \f$c\f$
+             */
+            ZipfInstanceGenerator( int apps, int posts, double skew, double tie, 
+                    int minLength, int maxLength, double alpha, int capacity ) 
+                : StructuredInstanceGenerator( apps, posts ), 
+                  Skew( skew ), TieProbability( tie ), MinLength( minLength ), 
+                  MaxLength( maxLength ), Alpha( alpha ), Capacity( capacity )
+            {
+                assert( Skew >= 0.0 );
+                assert( TieProbability >= 0.0 && TieProbability <= 1.0 );
+                assert( MinLength >= 1 && MinLength <= MaxLength );
+                assert( Alpha >= 0.0 );
+                assert( Capacity >= 1 );
+            }
+
+            /*! \brief Create a new generator
+             *
+             *  \param apps Number of applicants \f$n\f$
+             *  \param posts Number of posts \f$m\f$
+             *  \param skew Skew of the post popularity \f$s\f$
+             *  \param tie Tie probability \f$t\f$
+             *  \param minLength Minimum length of a preference list \f$\ell_{min}\f$
+             *  \param maxLength Maximum length of a preference list \f$\ell_{max}\f$
+             *  \param alpha Exponent of the list length distribution \f$\alpha\f$
+             *  \param capacity Capacity of each post \f$c\f$
+             *  \param seed Seed value for the random number generator
+             */
+            ZipfInstanceGenerator( int apps, int posts, double skew, double tie, 
+                    int minLength, int maxLength, double alpha, int capacity, int seed ) 
+                : StructuredInstanceGenerator( apps, posts, seed ), 
+                  Skew( skew ), TieProbability( tie ), MinLength( minLength ), 
+                  MaxLength( maxLength ), Alpha( alpha ), Capacity( capacity )
+            {
+                assert( Skew >= 0.0 );
+                assert( TieProbability >= 0.0 && TieProbability <= 1.0 );
+                assert( MinLength >= 1 && MinLength <= MaxLength );
+                assert( Alpha >= 0.0 );
+                assert( Capacity >= 1 );
+            }
+
+            ~ZipfInstanceGenerator()
+            {
+            }
+
+        private:
+
+            virtual void GenerateEdges( leda::graph& G, 
+                    leda::list<leda::node>& A,
+                    leda::list<leda::node>& B,
+                    leda::node_map<int>& capacity,
+                    leda::edge_map<int>& rank );
+
+            const double Skew;
+            const double TieProbability;
+            const int MinLength;
+            const int MaxLength;
+            const double Alpha;
+            const int Capacity;
+    };
+
 }
 
 #endif  // LEP_GENERATOR_H
@@ -0,0 +1,320 @@
+//
+// This program can be freely used in an academic environment
+// ONLY for research purposes, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    an acknowledgment in the product documentation is required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// Any other use is strictly prohibited by the author, without an explicit
+// permission.
+//
+// Note that this program uses the LEDA library, which is NOT free. For more
+// details visit Algorithmic Solutions at http://www.algorithmic-solutions.com/
+//
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+// ! Any commercial use of this software is strictly !
+// ! prohibited without explicit permission by the   !
+// ! author.                                         !
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// Copyright (C) 2004-2010 Dimitrios Michail <dimitrios.michail@gmail.com>
+//
+
+/*! \file graph_traits.h
+ *  \brief Adapters presenting graph types to the templated engines.
+ *
+ *  \ingroup instance
+ */
+
+#ifndef LEP_GRAPH_TRAITS_H
+#define LEP_GRAPH_TRAITS_H
+
+#include <LEP/mosp/config.h>
+#include <LEP/mosp/instance.h>
+#include <cstddef>
+#include <vector>
+
+#ifdef LEDA_GE_V5
+#include <LEDA/graph/graph.h>
+#include <LEDA/graph/edge_array.h>
+#else
+#include <LEDA/graph.h>
+#include <LEDA/edge_array.h>
+#endif
+
+namespace mosp
+{
+
+/*! \brief A bipartite graph with ranks in compressed sparse row form.
+ *
+ *  The nodes are the integers \f$0, \ldots, a+p-1\f$, where the first 
+ *  \f$a\f$ are the applicants, the left side, and the other \f$p\f$ are 
+ *  the posts. The graph is built from the preference lists of the 
+ *  applicants, each sorted by rank, and stores every edge at both 
+ *  endpoints, the lists of the posts sorted by rank as well. The entries 
+ *  of the applicants keep the positions they have in the given arrays, 
+ *  which identify the edges.
+ *  \ingroup instance
+ */
+class CsrGraph
+{
+    public:
+        /*! \brief Build a graph from preference lists.
+         *  \param applicants The number of applicants.
+         *  \param posts The number of posts.
+         *  \param offset The preference list of applicant \f$i\f$ is at positions 
+         *                offset[i] to offset[i+1]-1, applicants + 1 entries.
+         *  \param post The post of each entry, from 0 to posts-1.
+         *  \param rank The positive rank of each entry, non-decreasing along each list.
+         */
+        CsrGraph( int applicants, int posts, 
+                  const std::vector<size_t>& offset, 
+                  const std::vector<int>& post, 
+                  const std::vector<int>& rank );
+
+        /*! \brief Number of applicants. */
+        int Applicants() const { return applicants; }
+
+        /*! \brief Number of nodes, applicants and posts. */
+        int Nodes() const { return (int) begin.size() - 1; }
+
+        /*! \brief Number of edges. */
+        size_t Edges() const { return target.size() / 2; }
+
+        /*! \brief The first entry of node v. */
+        size_t Begin( int v ) const { return begin[v]; }
+
+        /*! \brief Past the last entry of node v. */
+        size_t End( int v ) const { return begin[v+1]; }
+
+        /*! \brief The node at the other end of entry k. */
+        int Target( size_t k ) const { return target[k]; }
+
+        /*! \brief The rank of entry k. */
+        int Rank( size_t k ) const { return rank[k]; }
+
+        /*! \brief The minimum rank, zero if there are no edges. */
+        int MinRank() const { return minRank; }
+
+        /*! \brief The maximum rank, zero if there are no edges. */
+        int MaxRank() const { return (int) rankSize.size() - 1; }
+
+        /*! \brief Number of edges of rank r. */
+        int RankSize( int r ) const 
+        { 
+            return ( r < 0 || r >= (int) rankSize.size() ) ? 0 : rankSize[r];
+        }
+
+    private:
+        int applicants;
+        int minRank;
+        std::vector<size_t> begin;
+        std::vector<int> target;
+        std::vector<int> rank;
+        std::vector<int> rankSize;
+};
+
+/*! \brief Access of the templated engines to a graph type.
+ *
+ *  An adapter is constructed from the graph and presents 
+ *  - the nodes, by first_node() and next_node() until is_node() fails, 
+ *    and a dense index of each node, smaller than index_bound(),
+ *  - the nodes of the left side, by in_A(),
+ *  - the edges incident to a node sorted by rank, by adj_begin(), 
+ *    adj_next() and adj_end(), with the index of the opposite node, 
+ *    the rank and a handle of the edge of each position,
+ *  - the range of the ranks and the number of edges of each rank.
+ *
+ *  Adapters exist for an Instance, thus for a leda::graph and an edge 
+ *  array of ranks, for a leda::GRAPH whose edge information is the rank, 
+ *  and for a CsrGraph. The engines are instantiated for each of them and 
+ *  read the graph in place, without copying it or calling a virtual 
+ *  function.
+ *  \ingroup instance
+ */
+template<class Graph> class graph_traits;
+
+/*! \brief A validated instance. The edge handles are the edges of the graph.
+ *  \ingroup instance
+ */
+template<> class graph_traits<Instance>
+{
+    public:
+        typedef leda::node node_type;
+        typedef leda::edge edge_type;
+        typedef const leda::edge* adj_iterator;
+
+        graph_traits( const Instance& I ) 
+            : I( I ), G( I.Graph() ), inA( G.max_node_index() + 1, 0 ) 
+        { 
+            leda::node v;
+            forall( v, I.A() ) 
+                inA[ G.index(v) ] = 1;
+        }
+
+        int index_bound() const { return G.max_node_index() + 1; }
+        int number_of_nodes() const { return G.number_of_nodes(); }
+        size_t number_of_edges() const { return G.number_of_edges(); }
+        int size_of_A() const { return I.A().size(); }
+
+        node_type first_node() const { return G.first_node(); }
+        node_type next_node( node_type v ) const { return G.succ_node( v ); }
+        bool is_node( node_type v ) const { return v != nil; }
+        unsigned int index( node_type v ) const { return G.index( v ); }
+        bool in_A( node_type v ) const { return inA[ G.index(v) ] != 0; }
+
+        int degree( node_type v ) const { return I.Degree( v ); }
+        adj_iterator adj_begin( node_type v ) const { return I.AdjBegin( v ); }
+        adj_iterator adj_end( node_type v ) const { return I.AdjEnd( v ); }
+        adj_iterator adj_next( adj_iterator p, node_type ) const { return p + 1; }
+        unsigned int opposite( adj_iterator p, node_type v ) const { return G.index( G.opposite( *p, v ) ); }
+        int rank( adj_iterator p ) const { return I.Rank()[ *p ]; }
+        edge_type edge( adj_iterator p ) const { return *p; }
+
+        int min_rank() const { return I.MinRank(); }
+        int max_rank() const { return I.MaxRank(); }
+        int rank_size( int r ) const { return I.RankSize( r ); }
+
+    private:
+        const Instance& I;
+        const leda::graph& G;
+        std::vector<char> inA;
+};
+
+/*! \brief A parameterized graph whose edge information is the rank. 
+ *
+ *  The edges must be directed from the left side to the right side, thus 
+ *  the left side are the nodes with outgoing edges, and the outgoing and 
+ *  incoming edges of each node must be sorted by rank, as left by 
+ *  <tt>G.sort_edges()</tt>. The ranks must be positive. The adapter 
+ *  checks this and computes the rank sizes in time \f$O(n + m)\f$. 
+ *  The edge handles are the edges of the graph.
+ *  \ingroup instance
+ */
+template<class V, class E> class graph_traits< leda::GRAPH<V,E> >
+{
+    public:
+        typedef leda::node node_type;
+        typedef leda::edge edge_type;
+        typedef leda::edge adj_iterator;
+
+        graph_traits( const leda::GRAPH<V,E>& G ) : G( G ), nA( 0 ), minRank( 0 ) 
+        { 
+            leda::node v;
+            forall_nodes( v, G ) { 
+                if ( G.outdeg( v ) > 0 && G.indeg( v ) > 0 ) 
+                    leda::error_handler(999, "graph_traits: edges not directed from A to B");
+                if ( G.outdeg( v ) > 0 ) 
+                    nA++;
+                int last = 0;
+                for( leda::edge e = adj_begin( v ); e != nil; e = adj_next( e, v ) ) { 
+                    int r = rank( e );
+                    if ( r <= 0 ) 
+                        leda::error_handler(999, "graph_traits: illegal rank (non-positive)");
+                    if ( r < last ) 
+                        leda::error_handler(999, "graph_traits: adjacency lists not sorted by rank");
+                    last = r;
+                    if ( G.outdeg( v ) == 0 ) 
+                        continue;
+                    if ( r >= (int) rankSize.size() ) 
+                        rankSize.resize( r + 1, 0 );
+                    rankSize[r]++;
+                    if ( minRank == 0 || r < minRank ) 
+                        minRank = r;
+                }
+            }
+        }
+
+        int index_bound() const { return G.max_node_index() + 1; }
+        int number_of_nodes() const { return G.number_of_nodes(); }
+        size_t number_of_edges() const { return G.number_of_edges(); }
+        int size_of_A() const { return nA; }
+
+        node_type first_node() const { return G.first_node(); }
+        node_type next_node( node_type v ) const { return G.succ_node( v ); }
+        bool is_node( node_type v ) const { return v != nil; }
+        unsigned int index( node_type v ) const { return G.index( v ); }
+        bool in_A( node_type v ) const { return G.outdeg( v ) > 0; }
+
+        int degree( node_type v ) const { return G.outdeg( v ) + G.indeg( v ); }
+        adj_iterator adj_begin( node_type v ) const 
+        { 
+            return G.outdeg( v ) > 0 ? G.first_adj_edge( v ) : G.first_in_edge( v );
+        }
+        adj_iterator adj_end( node_type ) const { return nil; }
+        adj_iterator adj_next( adj_iterator e, node_type v ) const 
+        { 
+            return G.outdeg( v ) > 0 ? G.adj_succ( e ) : G.in_succ( e );
+        }
+        unsigned int opposite( adj_iterator e, node_type v ) const { return G.index( G.opposite( e, v ) ); }
+        int rank( adj_iterator e ) const { return (int) G.inf( e ); }
+        edge_type edge( adj_iterator e ) const { return e; }
+
+        int min_rank() const { return minRank; }
+        int max_rank() const { return rankSize.empty() ? 0 : (int) rankSize.size() - 1; }
+        int rank_size( int r ) const 
+        { 
+            return ( r < 0 || r >= (int) rankSize.size() ) ? 0 : rankSize[r];
+        }
+
+    private:
+        const leda::GRAPH<V,E>& G;
+        int nA;
+        int minRank;
+        std::vector<int> rankSize;
+};
+
+/*! \brief A graph in compressed sparse row form. The nodes are their own 
+ *         indices and the handle of an edge is the position of its entry 
+ *         at the applicant.
+ *  \ingroup instance
+ */
+template<> class graph_traits<CsrGraph>
+{
+    public:
+        typedef int node_type;
+        typedef size_t edge_type;
+        typedef size_t adj_iterator;
+
+        graph_traits( const CsrGraph& G ) : G( G ) {}
+
+        int index_bound() const { return G.Nodes(); }
+        int number_of_nodes() const { return G.Nodes(); }
+        size_t number_of_edges() const { return G.Edges(); }
+        int size_of_A() const { return G.Applicants(); }
+
+        node_type first_node() const { return 0; }
+        node_type next_node( node_type v ) const { return v + 1; }
+        bool is_node( node_type v ) const { return v < G.Nodes(); }
+        unsigned int index( node_type v ) const { return v; }
+        bool in_A( node_type v ) const { return v < G.Applicants(); }
+
+        int degree( node_type v ) const { return (int) ( G.End( v ) - G.Begin( v ) ); }
+        adj_iterator adj_begin( node_type v ) const { return G.Begin( v ); }
+        adj_iterator adj_end( node_type v ) const { return G.End( v ); }
+        adj_iterator adj_next( adj_iterator k, node_type ) const { return k + 1; }
+        unsigned int opposite( adj_iterator k, node_type ) const { return G.Target( k ); }
+        int rank( adj_iterator k ) const { return G.Rank( k ); }
+        edge_type edge( adj_iterator k ) const { return k; }
+
+        int min_rank() const { return G.MinRank(); }
+        int max_rank() const { return G.MaxRank(); }
+        int rank_size( int r ) const { return G.RankSize( r ); }
+
+    private:
+        const CsrGraph& G;
+};
+
+}
+
+#endif  // LEP_GRAPH_TRAITS_H
+
+/* ex: set ts=4 sw=4 sts=4 et: */
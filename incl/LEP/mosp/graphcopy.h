@@ -71,8 +71,10 @@ namespace mosp
     using leda::error_handler;
 #endif
 
-    // TODO: make this use template specialization and traits
-    //       so that it works for both GRAPH<V,E> and plain graph
+    // A copy of a graph which can be modified. The engines which only 
+    // read the graph take any graph type through graph_traits instead, 
+    // see RANK_MAX_MATCHING_COMPACT_T.h; the popular and capacitated 
+    // engines delete and hide edges and keep working on a copy.
 
     class graph_copy: public graph
     {
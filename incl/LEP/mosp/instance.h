@@ -0,0 +1,298 @@
+//
+// This program can be freely used in an academic environment
+// ONLY for research purposes, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    an acknowledgment in the product documentation is required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// Any other use is strictly prohibited by the author, without an explicit
+// permission.
+//
+// Note that this program uses the LEDA library, which is NOT free. For more
+// details visit Algorithmic Solutions at http://www.algorithmic-solutions.com/
+//
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+// ! Any commercial use of this software is strictly !
+// ! prohibited without explicit permission by the   !
+// ! author.                                         !
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// Copyright (C) 2004-2010 Dimitrios Michail <dimitrios.michail@gmail.com>
+
+
+/*! \file instance.h
+ *  \brief Validated and prepared matching instances which can be solved many times.
+ */
+
+#ifndef LEP_INSTANCE_H
+#define LEP_INSTANCE_H
+
+#include <LEP/mosp/config.h>
+#include <algorithm>
+#include <vector>
+
+#ifdef LEDA_GE_V5
+#include <LEDA/core/list.h>
+#include <LEDA/graph/graph.h>
+#include <LEDA/graph/edge_array.h>
+#include <LEDA/graph/node_array.h>
+#else
+#include <LEDA/list.h>
+#include <LEDA/graph.h>
+#include <LEDA/edge_array.h>
+#include <LEDA/node_array.h>
+#endif
+
+namespace mosp
+{
+
+/*! \brief The outcome of validating a matching instance.
+ *  \ingroup instance
+ */
+struct InstanceValidation
+{
+    /*! \brief Whether the graph is bipartite with respect to the partition. */
+    bool bipartite;
+
+    /*! \brief Whether the graph has no self loops. */
+    bool loopfree;
+
+    /*! \brief Whether the graph has no parallel edges, in either direction. */
+    bool simple;
+
+    /*! \brief Whether all ranks are positive. */
+    bool positiveRanks;
+
+    /*! \brief The minimum rank of an edge, zero if there are no edges. */
+    int minRank;
+
+    /*! \brief The maximum rank of an edge, zero if there are no edges. */
+    int maxRank;
+
+    /*! \brief Create the validation of the empty instance. */
+    InstanceValidation() : bipartite( true ), loopfree( true ), simple( true ), 
+        positiveRanks( true ), minRank( 0 ), maxRank( 0 ) 
+    {
+    }
+
+    /*! \brief Whether all checks passed. */
+    bool Valid() const { return bipartite && loopfree && simple && positiveRanks; }
+
+    /*! \brief A description of the first failed check, nil if valid. */
+    const char* Error() const;
+};
+
+/*! \brief Validate a matching instance and compute a bipartition.
+ *
+ *  Checks bipartiteness, self loops, parallel edges and the positivity of the 
+ *  ranks in a single breadth-first traversal, in time \f$O(n + m)\f$. Parallel 
+ *  edges are detected by stamping the neighbors of each node with the node 
+ *  itself, which requires neither sorting nor hashing. Each connected component 
+ *  is rooted at its first node, which goes to \f$A\f$ unless it has only 
+ *  incoming edges, so that a graph already directed from \f$A\f$ to \f$B\f$ 
+ *  keeps its orientation.
+ *  \param G The graph
+ *  \param rank A rank function on the edges.
+ *  \param A Filled with the nodes of the left side. Meaningful only if the graph is bipartite.
+ *  \param B Filled with the nodes of the right side. Meaningful only if the graph is bipartite.
+ *  \return The outcome of the checks.
+ *  \ingroup instance
+ */
+InstanceValidation VALIDATE_INSTANCE( const leda::graph& G, 
+                const leda::edge_array<int>& rank,
+                leda::list<leda::node>& A, 
+                leda::list<leda::node>& B );
+
+/*! \brief Validate a matching instance with a given bipartition.
+ *
+ *  As above, in a single pass over the adjacency lists. Nodes not in \f$A\f$ are 
+ *  considered to be in \f$B\f$.
+ *  \param G The graph
+ *  \param A The nodes of the left side.
+ *  \param B The nodes of the right side.
+ *  \param rank A rank function on the edges.
+ *  \return The outcome of the checks.
+ *  \ingroup instance
+ */
+InstanceValidation VALIDATE_INSTANCE( const leda::graph& G, 
+                const leda::list<leda::node>& A, 
+                const leda::list<leda::node>& B, 
+                const leda::edge_array<int>& rank );
+
+/*! \brief Sort the adjacency lists of a graph by rank.
+ *
+ *  The edges are bucketed by rank with a counting sort and the adjacency 
+ *  lists are rearranged in the bucket order, in time \f$O(n + m + r)\f$ where 
+ *  \f$r\f$ is the range of the ranks. If the range is more than four times the 
+ *  number of edges, the edges are sorted by comparison instead. The result 
+ *  is the order of <tt>G.sort_edges( rank )</tt>, and edges of the same rank 
+ *  keep their relative order.
+ *  \param G The graph
+ *  \param rank A rank function on the edges.
+ *  \ingroup instance
+ */
+void SORT_EDGES_BY_RANK( leda::graph& G, const leda::edge_array<int>& rank );
+
+/*! \brief A validated and prepared matching instance.
+ *
+ *  The instance is validated and prepared once, at construction. The outcome 
+ *  of the validation is cached together with the bipartition and the rank range. 
+ *  The edges are directed from \f$A\f$ to \f$B\f$ and are sorted by rank as by 
+ *  SORT_EDGES_BY_RANK. The instance owns a compressed sparse row copy of the 
+ *  adjacency lists with the edges of each node sorted by rank, and the offsets 
+ *  of the edges of each distinct rank, thus its size does not depend on the 
+ *  values of the ranks. The adjacency lists of the graph are arranged in the 
+ *  same order.
+ *
+ *  The solvers and audits accepting an instance skip validation and preprocessing 
+ *  and leave the adjacency lists of the graph sorted by rank when they return, 
+ *  thus repeated solves on the same instance pay for these only once. The instance 
+ *  keeps references to the graph, the ranks and the capacities, which must outlive 
+ *  it. The graph must not be modified by other means while the instance is in use.
+ *  \ingroup instance
+ */
+class Instance
+{
+    public:
+        /*! \brief Validate and prepare a graph, computing a bipartition.
+         *  \param G The graph
+         *  \param rank A rank function on the edges.
+         */
+        Instance( leda::graph& G, const leda::edge_array<int>& rank );
+
+        /*! \brief Validate and prepare a graph with a given bipartition.
+         *  \param G The graph
+         *  \param A The nodes of the left side.
+         *  \param B The nodes of the right side.
+         *  \param rank A rank function on the edges.
+         */
+        Instance( leda::graph& G, 
+                  const leda::list<leda::node>& A, 
+                  const leda::list<leda::node>& B, 
+                  const leda::edge_array<int>& rank );
+
+        /*! \brief Validate and prepare a capacitated instance.
+         *  \param G The graph
+         *  \param A The nodes of the left side.
+         *  \param B The nodes of the right side.
+         *  \param rank A rank function on the edges.
+         *  \param capacity Node capacities, one for the nodes of the left side.
+         */
+        Instance( leda::graph& G, 
+                  const leda::list<leda::node>& A, 
+                  const leda::list<leda::node>& B, 
+                  const leda::edge_array<int>& rank, 
+                  const leda::node_array<int>& capacity );
+
+        /*! \brief The graph. */
+        leda::graph& Graph() const { return G; }
+
+        /*! \brief The rank function. */
+        const leda::edge_array<int>& Rank() const { return rank; }
+
+        /*! \brief The nodes of the left side. */
+        const leda::list<leda::node>& A() const { return left; }
+
+        /*! \brief The nodes of the right side. */
+        const leda::list<leda::node>& B() const { return right; }
+
+        /*! \brief The minimum rank of an edge. */
+        int MinRank() const { return validation.minRank; }
+
+        /*! \brief The maximum rank of an edge. */
+        int MaxRank() const { return validation.maxRank; }
+
+        /*! \brief The cached outcome of the validation. */
+        const InstanceValidation& Validation() const { return validation; }
+
+        /*! \brief Whether capacities were given. */
+        bool HasCapacities() const { return capacity != 0; }
+
+        /*! \brief The capacities, nil if none were given. */
+        const leda::node_array<int>* Capacities() const { return capacity; }
+
+        /*! \brief The capacity of a node, one if no capacities were given. */
+        int Capacity( leda::node v ) const { return capacity ? (*capacity)[v] : 1; }
+
+        /*! \brief Number of distinct ranks of the edges. */
+        int DistinctRanks() const { return (int) rankValue.size(); }
+
+        /*! \brief The i-th smallest distinct rank, for i from 0 to DistinctRanks()-1. */
+        int DistinctRank( int i ) const { return rankValue[i]; }
+
+        /*! \brief Number of edges of rank r. */
+        int RankSize( int r ) const { return RankEnd( r ) - RankBegin( r ); }
+
+        /*! \brief The first edge of rank r, the edges of each rank are consecutive. */
+        const leda::edge* RankBegin( int r ) const { return at( rankEdge, rankOffset, rankIndex( r ) ); }
+
+        /*! \brief Past the last edge of rank r. */
+        const leda::edge* RankEnd( int r ) const 
+        { 
+            int i = rankIndex( r );
+            if ( i < (int) rankValue.size() && rankValue[i] == r ) 
+                i++;
+            return at( rankEdge, rankOffset, i );
+        }
+
+        /*! \brief Number of edges incident to a node. */
+        int Degree( leda::node v ) const 
+        { 
+            return adjOffset[ G.index(v)+1 ] - adjOffset[ G.index(v) ];
+        }
+
+        /*! \brief The first edge incident to a node, the edges are sorted by rank. */
+        const leda::edge* AdjBegin( leda::node v ) const { return at( adjEdge, adjOffset, G.index(v) ); }
+
+        /*! \brief Past the last edge incident to a node. */
+        const leda::edge* AdjEnd( leda::node v ) const { return at( adjEdge, adjOffset, G.index(v)+1 ); }
+
+        /*! \brief Arrange the adjacency lists of the graph by rank again, in linear time. 
+         *
+         *  Needed only after modifying the graph by other means than the functions 
+         *  accepting an instance, for example by hiding and restoring edges.
+         */
+        void RestoreOrder() const;
+
+    private:
+        void require() const;
+        void prepare();
+
+        // the index of the smallest distinct rank not less than r
+        int rankIndex( int r ) const 
+        { 
+            return std::lower_bound( rankValue.begin(), rankValue.end(), r ) - rankValue.begin();
+        }
+
+        static const leda::edge* at( const std::vector<leda::edge>& v, 
+                const std::vector<int>& offset, int i ) 
+        { 
+            return v.empty() ? 0 : &v[0] + offset[i];
+        }
+
+        leda::graph& G;
+        const leda::edge_array<int>& rank;
+        const leda::node_array<int>* capacity;
+        leda::list<leda::node> left, right;
+        InstanceValidation validation;
+
+        std::vector<int> rankValue;
+        std::vector<int> rankOffset;
+        std::vector<leda::edge> rankEdge;
+        std::vector<int> adjOffset;
+        std::vector<leda::edge> adjEdge;
+};
+
+}
+
+#endif  // LEP_INSTANCE_H
+
+/* ex: set ts=4 sw=4 sts=4 et: */
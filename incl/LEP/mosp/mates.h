@@ -0,0 +1,126 @@
+//
+// This program can be freely used in an academic environment
+// ONLY for research purposes, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    an acknowledgment in the product documentation is required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// Any other use is strictly prohibited by the author, without an explicit
+// permission.
+//
+// Note that this program uses the LEDA library, which is NOT free. For more
+// details visit Algorithmic Solutions at http://www.algorithmic-solutions.com/
+//
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+// ! Any commercial use of this software is strictly !
+// ! prohibited without explicit permission by the   !
+// ! author.                                         !
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// Copyright (C) 2004-2010 Dimitrios Michail <dimitrios.michail@gmail.com>
+//
+
+/*! \file mates.h
+ *  \brief Matchings as flat arrays of mates.
+ *
+ *  A mate array holds for each node index of a graph the index of the 
+ *  mate of the node, or NO_MATE if the node is free. It takes four bytes 
+ *  per node in one block, which the caller allocates, for instance in 
+ *  shared memory, and which WRITE_MATES stores with a single write. The 
+ *  engines BI_RANK_MAX_MATCHING, BI_RANK_MAX_MATCHING_COMPACT and 
+ *  BI_POPULAR_MATCHING fill it directly from their solver state, without 
+ *  building a list of edges.
+ *
+ *  \ingroup instance
+ */
+
+#ifndef LEP_MATES_H
+#define LEP_MATES_H
+
+#include <LEP/mosp/config.h>
+#include <stdint.h>
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+#ifdef LEDA_GE_V5
+#include <LEDA/core/list.h>
+#include <LEDA/graph/graph.h>
+#include <LEDA/graph/node_array.h>
+#else
+#include <LEDA/list.h>
+#include <LEDA/graph.h>
+#include <LEDA/node_array.h>
+#endif
+
+namespace mosp
+{
+
+/*! \brief The entry of a free node in a mate array.
+ *  \ingroup instance
+ */
+const int32_t NO_MATE = -1;
+
+/*! \brief Number of entries of a mate array of a graph, one more than the largest node index.
+ *  \ingroup instance
+ */
+inline size_t MATE_ARRAY_SIZE( const leda::graph& G ) 
+{ 
+    return G.max_node_index() + 1;
+}
+
+/*! \brief Fill a mate array from a matching given as a list of edges.
+ *  \param G The graph.
+ *  \param L The edges of the matching.
+ *  \param mate An array of MATE_ARRAY_SIZE(G) entries.
+ *  \return The number of matched edges.
+ *  \ingroup instance
+ */
+int MATCHING_MATES( const leda::graph& G, 
+        const leda::list<leda::edge>& L, 
+        int32_t* mate );
+
+/*! \brief Fill a mate array from a matching given as the mate of each node.
+ *  \param G The graph.
+ *  \param m The mate of each node, nil if the node is free.
+ *  \param mate An array of MATE_ARRAY_SIZE(G) entries.
+ *  \return The number of matched edges.
+ *  \ingroup instance
+ */
+int MATCHING_MATES( const leda::graph& G, 
+        const leda::node_array<leda::node>& m, 
+        int32_t* mate );
+
+/*! \brief Write a mate array in binary form.
+ *
+ *  The entries are written as they are in memory, four bytes each in 
+ *  the byte order of the machine, by a single write of the stream.
+ *  \param o The stream, opened in binary mode.
+ *  \param mate The mate array.
+ *  \param n The number of entries.
+ *  \return True if the stream is good after the write.
+ *  \ingroup instance
+ */
+bool WRITE_MATES( std::ostream& o, const int32_t* mate, size_t n );
+
+/*! \brief Write a mate array in binary form.
+ *  \param o The stream, opened in binary mode.
+ *  \param mate The mate array.
+ *  \return True if the stream is good after the write.
+ *  \ingroup instance
+ */
+bool WRITE_MATES( std::ostream& o, const std::vector<int32_t>& mate );
+
+}
+
+#endif  // LEP_MATES_H
+
+/* ex: set ts=4 sw=4 sts=4 et: */
@@ -66,9 +66,15 @@
  *    (reducing the problem to the weighted matching problem). 
  *    See <a href="http://dx.doi.org/10.1016/j.tcs.2007.08.004">here</a> for more details.
  *  - Again an algorithm which reduces the problem to the weighted matching
- *    but this time with slower running time \f$O( n^2 ( m + n \log n ) )\f$ and 
- *    more space \f$O(mn + n^2)\f$. The extra \f$n\f$ comes from the possible cost of arithmetic
- *    since the algorithm handles numbers up to \f$O(n^n)\f$.
+ *    but this time with slower running time \f$O( r n ( m + n \log n ) )\f$ and 
+ *    more space \f$O(r n + m)\f$. The extra \f$r\f$ comes from the cost of arithmetic
+ *    since the algorithm handles weights up to \f$O(n^r)\f$ as vectors of dimension \f$r\f$.
+ *
+ *  Which of the three is fastest depends on the instance. The front-end 
+ *  RANK_MAX_MATCHING_AUTO extracts a few cheap features of the instance and 
+ *  dispatches to the engine with the smallest predicted running time.
+ *  RANK_MAX_MATCHING_DECOMPOSED first removes edges which no rank-maximal matching 
+ *  uses and then solves each connected component separately, optionally in parallel.
  *
  *  Except for the above, <b>libMOSP</b> contains an implementation of a rank-maximal matching
  *  algorithm with capacities. In this case the nodes of the right-side partition of the bipartite
@@ -255,6 +261,33 @@
  *      return 0;
  *  } 
  *  \endcode
+ *  \subsection ex_instance Solving an Instance Many Times
+ *  \code
+ *
+ *  #include <LEP/mosp/mosp.h>
+ *
+ *  int main() {
+ *
+ *      // construct G, A, B and rank as above
+ *
+ *      // validate, direct and sort the edges by rank once
+ *      mosp::Instance I( G, A, B, rank );
+ *
+ *      leda::list< leda::edge > M = mosp::BI_RANK_MAX_MATCHING( I );
+ *      leda::list< leda::edge > P;
+ *      bool is_popular = mosp::BI_POPULAR_MATCHING( I, P );
+ *      int margin = mosp::BI_UNPOPULARITY_MARGIN( I, M );
+ *
+ *      // reuse the scratch memory of the algorithms across solves
+ *      mosp::Workspace ws;
+ *      mosp::SolveStats stats;
+ *      mosp::SolveOptions options( &stats, &ws );
+ *      for( int i = 0; i < 10; ++i ) 
+ *          M = mosp::BI_RANK_MAX_MATCHING( I, options );
+ *
+ *      return 0;
+ *  }
+ *  \endcode
 
  *
  */
@@ -266,6 +299,9 @@
 /*! \defgroup rankmax Rank-Maximal Matchings
  *  \defgroup popular Popular Matchings
  *  \defgroup generator Random Structured Instance Generators 
+ *  \defgroup stats Runtime Statistics
+ *  \defgroup instance Validated Instances
+ *  \defgroup options Solve Options and Workspaces
  */
 
 #ifndef MOSP_H
@@ -273,6 +309,12 @@
 
 #include <LEP/mosp/RANK_MAX_MATCHING.h>
 #include <LEP/mosp/POPULAR.h>
+#include <LEP/mosp/stats.h>
+#include <LEP/mosp/instance.h>
+#include <LEP/mosp/graph_traits.h>
+#include <LEP/mosp/renumber.h>
+#include <LEP/mosp/mates.h>
+#include <LEP/mosp/options.h>
 
 #endif  // MOSP_H
 
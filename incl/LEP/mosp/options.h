@@ -0,0 +1,159 @@
+//
+// This program can be freely used in an academic environment
+// ONLY for research purposes, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    an acknowledgment in the product documentation is required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// Any other use is strictly prohibited by the author, without an explicit
+// permission.
+//
+// Note that this program uses the LEDA library, which is NOT free. For more
+// details visit Algorithmic Solutions at http://www.algorithmic-solutions.com/
+//
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+// ! Any commercial use of this software is strictly !
+// ! prohibited without explicit permission by the   !
+// ! author.                                         !
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// Copyright (C) 2004-2010 Dimitrios Michail <dimitrios.michail@gmail.com>
+//
+
+/*! \file options.h
+ *  \brief Options shared by the matching algorithms.
+ *
+ *  \ingroup options
+ */
+
+#ifndef LEP_OPTIONS_H
+#define LEP_OPTIONS_H
+
+#include <LEP/mosp/config.h>
+#include <LEP/mosp/stats.h>
+#include <LEP/mosp/workspace.h>
+
+namespace mosp
+{
+
+    /*! \brief Why a solve returned.
+     *  \ingroup options
+     */
+    enum SolveStatus { 
+        SOLVE_DONE = 0,         //!< the algorithm ran to completion
+        SOLVE_TIME_LIMIT = 1,   //!< the time limit expired
+        SOLVE_CANCELLED = 2     //!< the cancel callback returned true or the progress callback returned false
+    };
+
+    /*! \brief Progress of a solve, reported after each phase.
+     *  \ingroup options
+     */
+    struct SolveProgress
+    {
+        /*! \brief The phase just finished. */
+        int phase;
+
+        /*! \brief Size of the matching which would be returned now. */
+        int matched;
+
+        /*! \brief Number of applicants not matched at all. For popular matchings 
+         *         this counts applicants without even a last resort post, the 
+         *         search is complete when it becomes zero. */
+        int unmatched;
+
+        /*! \brief Wall clock time since the start of the solve, in seconds. */
+        double elapsed;
+    };
+
+    /*! \brief A progress callback.
+     *  \param progress The progress so far.
+     *  \param data The user data given in SolveOptions.
+     *  \return False to stop the solve.
+     *  \ingroup options
+     */
+    typedef bool (*SolveProgressCallback)( const SolveProgress& progress, void* data );
+
+    /*! \brief A cancel callback, polled while the solve runs.
+     *  \param data The user data given in SolveOptions.
+     *  \return True to stop the solve.
+     *  \ingroup options
+     */
+    typedef bool (*SolveCancelCallback)( void* data );
+
+    /*! \brief Per-solve options of the algorithms working on an Instance.
+     *
+     *  A pointer to SolveStats converts implicitly to options which only 
+     *  record statistics, so that 
+     *  \code BI_RANK_MAX_MATCHING( I, &stats ) \endcode
+     *  keeps working.
+     *
+     *  The time limit, the progress callback and the cancel callback are honoured 
+     *  by the popular matching algorithms, which are checked between phases 
+     *  and between the rounds of the maximum matching computations. A stopped 
+     *  solve returns the matching found so far, which is the largest one 
+     *  computed in the lowest phase reached.
+     *
+     *  \ingroup options
+     */
+    struct SolveOptions
+    {
+        /*! \brief If not nil, runtime statistics of the algorithm are recorded here. */
+        SolveStats* stats;
+
+        /*! \brief If not nil, the scratch queues and stacks of the algorithm are 
+         *         allocated here instead of in a workspace private to the solve. 
+         *         Passing the same workspace to many solves avoids heap 
+         *         allocations once it has grown to the size of the instances. */
+        Workspace* workspace;
+
+        /*! \brief Wall clock time budget in seconds, no limit if not positive. */
+        double timeLimit;
+
+        /*! \brief If not nil, called after each phase. */
+        SolveProgressCallback progress;
+
+        /*! \brief Passed to the progress callback. */
+        void* progressData;
+
+        /*! \brief If not nil, polled between the rounds of the solve, which 
+         *         stops as soon as possible after it returns true. To cancel 
+         *         from another thread the callback reads a flag with the 
+         *         synchronization shared with that thread, for instance under 
+         *         a mutex or with an atomic load. */
+        SolveCancelCallback cancel;
+
+        /*! \brief Passed to the cancel callback. */
+        void* cancelData;
+
+        /*! \brief If not nil, the reason the solve returned is stored here. */
+        SolveStatus* status;
+
+        /*! \brief Directory of the scratch files of the engines which keep 
+         *         edges out of core. If nil, TMPDIR or else /tmp is used. */
+        const char* scratchDirectory;
+
+        /*! \brief Create options
+         *  \param s Where to record statistics, may be nil.
+         *  \param w The workspace to use, may be nil.
+         */
+        SolveOptions( SolveStats* s = 0, Workspace* w = 0 ) 
+            : stats( s ), workspace( w ), timeLimit( 0.0 ), progress( 0 ), 
+              progressData( 0 ), cancel( 0 ), cancelData( 0 ), status( 0 ), 
+              scratchDirectory( 0 )
+        {
+        }
+    };
+
+}
+
+#endif  // LEP_OPTIONS_H
+
+/* ex: set ts=4 sw=4 sts=4 et: */
@@ -0,0 +1,158 @@
+//
+// This program can be freely used in an academic environment
+// ONLY for research purposes, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    an acknowledgment in the product documentation is required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// Any other use is strictly prohibited by the author, without an explicit
+// permission.
+//
+// Note that this program uses the LEDA library, which is NOT free. For more
+// details visit Algorithmic Solutions at http://www.algorithmic-solutions.com/
+//
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+// ! Any commercial use of this software is strictly !
+// ! prohibited without explicit permission by the   !
+// ! author.                                         !
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// Copyright (C) 2004-2010 Dimitrios Michail <dimitrios.michail@gmail.com>
+//
+
+/*! \file renumber.h
+ *  \brief Renumbering the nodes of an instance for memory locality.
+ *
+ *  \ingroup instance
+ */
+
+#ifndef LEP_RENUMBER_H
+#define LEP_RENUMBER_H
+
+#include <LEP/mosp/config.h>
+#include <LEP/mosp/instance.h>
+#include <vector>
+
+#ifdef LEDA_GE_V5
+#include <LEDA/core/list.h>
+#include <LEDA/graph/graph.h>
+#include <LEDA/graph/edge_array.h>
+#include <LEDA/graph/node_array.h>
+#else
+#include <LEDA/list.h>
+#include <LEDA/graph.h>
+#include <LEDA/edge_array.h>
+#include <LEDA/node_array.h>
+#endif
+
+namespace mosp
+{
+
+/*! \brief Orders of the nodes of a renumbered instance.
+ *  \ingroup instance
+ */
+enum NodeOrder 
+{ 
+    /*! \brief The order of the input graph. */
+    ORDER_INPUT = 0,
+    /*! \brief Breadth first search order, started from the applicants in input order. */
+    ORDER_BFS = 1,
+    /*! \brief Reverse Cuthill-McKee order, which keeps the neighbors of a node close to it. */
+    ORDER_RCM = 2,
+    /*! \brief Each post followed by the applicants which rank it first. */
+    ORDER_FIRST_CHOICE = 3
+};
+
+/*! \brief Compute an order of the nodes of an instance for memory locality.
+ *
+ *  Runs in time \f$O(n + m)\f$, except for the reverse Cuthill-McKee order 
+ *  which also sorts the new neighbors of each node by degree.
+ *  \param I The instance
+ *  \param order The kind of order.
+ *  \param nodes Filled with all nodes of the graph of the instance in the new order.
+ *  \ingroup instance
+ */
+void LOCALITY_ORDER( const Instance& I, NodeOrder order, std::vector<leda::node>& nodes );
+
+/*! \brief A copy of an instance with the nodes renumbered for locality.
+ *
+ *  LEDA numbers the nodes and edges of a graph in order of creation, which is 
+ *  also the layout of the node and edge arrays of the algorithms. Instances 
+ *  created in an order unrelated to their structure, for example applicants 
+ *  in id order unrelated to their region, make the searches of the algorithms 
+ *  jump across memory. The copy creates the nodes in the order given by 
+ *  LOCALITY_ORDER() and the edges of each applicant consecutively in rank 
+ *  order, and is prepared as an Instance. Solve the copy and map the 
+ *  matching back with Original().
+ *
+ *  \code
+ *  mosp::Instance I( G, A, B, rank );
+ *  mosp::RenumberedInstance R( I, mosp::ORDER_RCM );
+ *  leda::list< leda::edge > M = R.Original( mosp::BI_RANK_MAX_MATCHING( R.Renumbered() ) );
+ *  \endcode
+ *  \ingroup instance
+ */
+class RenumberedInstance
+{
+    public:
+        /*! \brief Copy an instance, renumbering its nodes.
+         *  \param I The instance
+         *  \param order The order of the nodes of the copy.
+         */
+        RenumberedInstance( const Instance& I, NodeOrder order );
+
+        ~RenumberedInstance();
+
+        /*! \brief The renumbered instance. */
+        const Instance& Renumbered() const { return *instance; }
+
+        /*! \brief The graph of the renumbered instance. */
+        leda::graph& Graph() { return H; }
+
+        /*! \brief The ranks of the edges of the copy. */
+        const leda::edge_array<int>& Rank() const { return rank; }
+
+        /*! \brief The capacities of the nodes of the copy, one if the instance had none. */
+        const leda::node_array<int>& Capacity() const { return capacity; }
+
+        /*! \brief The applicants of the copy, in the new order. */
+        const leda::list<leda::node>& A() const { return left; }
+
+        /*! \brief The posts of the copy, in the new order. */
+        const leda::list<leda::node>& B() const { return right; }
+
+        /*! \brief The node of the original instance for a node of the copy. */
+        leda::node Original( leda::node v ) const { return origNode[v]; }
+
+        /*! \brief The edge of the original instance for an edge of the copy. */
+        leda::edge Original( leda::edge e ) const { return origEdge[e]; }
+
+        /*! \brief Map a list of edges of the copy, for example a matching, to the original instance. */
+        leda::list<leda::edge> Original( const leda::list<leda::edge>& L ) const;
+
+    private:
+        RenumberedInstance( const RenumberedInstance& );
+        RenumberedInstance& operator=( const RenumberedInstance& );
+
+        leda::graph H;
+        leda::edge_array<int> rank;
+        leda::node_array<int> capacity;
+        leda::node_array<leda::node> origNode;
+        leda::edge_array<leda::edge> origEdge;
+        leda::list<leda::node> left, right;
+        Instance* instance;
+};
+
+}
+
+#endif  // LEP_RENUMBER_H
+
+/* ex: set ts=4 sw=4 sts=4 et: */
@@ -0,0 +1,188 @@
+//
+// This program can be freely used in an academic environment
+// ONLY for research purposes, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    an acknowledgment in the product documentation is required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// Any other use is strictly prohibited by the author, without an explicit
+// permission.
+//
+// Note that this program uses the LEDA library, which is NOT free. For more
+// details visit Algorithmic Solutions at http://www.algorithmic-solutions.com/
+//
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+// ! Any commercial use of this software is strictly !
+// ! prohibited without explicit permission by the   !
+// ! author.                                         !
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// Copyright (C) 2004-2010 Dimitrios Michail <dimitrios.michail@gmail.com>
+//
+
+/*! \file sampling.h
+ *  \brief Random sampling primitives shared by the instance generators.
+ *
+ *  \ingroup generator
+ */
+
+#ifndef LEP_SAMPLING_H
+#define LEP_SAMPLING_H
+
+#include <LEP/mosp/config.h>
+
+#ifdef LEDA_GE_V5
+#include <LEDA/core/random_source.h>
+#include <LEDA/core/array.h>
+#include <LEDA/system/assert.h>
+#else
+#include <LEDA/random_source.h>
+#include <LEDA/array.h>
+#include <LEDA/std/assert.h>
+#endif
+
+namespace mosp
+{
+
+    /*! \brief A discrete distribution prepared for constant time sampling.
+     *
+     *  Walker's alias method (in the variant of Vose). After a linear time 
+     *  preprocessing of the weights, each sample costs one random number 
+     *  and two array accesses, independently of the number of outcomes.
+     *  Samples are drawn using RandomSampler::Discrete().
+     *
+     *  \ingroup generator
+     */
+    class AliasTable
+    {
+        public:
+
+            /*! \brief Create an empty table */
+            AliasTable() {}
+
+            /*! \brief Create a table
+             *  \param w Non-negative weights, at least one of them positive. 
+             */
+            AliasTable( const leda::array<double>& w ) { Init( w ); }
+
+            /*! \brief Prepare the table for a new distribution
+             *  \param w Non-negative weights, at least one of them positive. Outcome
+             *           \f$i\f$ is drawn with probability proportional to w[w.low()+i].
+             */
+            void Init( const leda::array<double>& w );
+
+            /*! \brief Number of outcomes */
+            int Size() const { return prob.size(); }
+
+        private:
+            friend class RandomSampler;
+
+            leda::array<double> prob;
+            leda::array<int> alias;
+    };
+
+    /*! \brief Random sampling on top of a LEDA random source.
+     *
+     *  The sampler does not own its random source, it only draws from it. All
+     *  generators share the same implementation so that the cost of building an
+     *  instance is proportional to the number of edges created and not to the
+     *  number of posts.
+     *
+     *  \ingroup generator
+     */
+    class RandomSampler
+    {
+        public:
+
+            /*! \brief Create a sampler
+             *  \param rs The random source to draw from (in double mode).
+             */
+            RandomSampler( leda::random_source& rs ) : randomSource( rs ) {}
+
+            /*! \brief Sample without replacement.
+             *
+             *  Draws \f$k\f$ distinct integers uniformly at random from \f$\{0,1,\ldots,n-1\}\f$.
+             *  The result is in the (random) order in which the elements were drawn. This
+             *  is a partial Fisher-Yates shuffle on an implicit identity permutation; only the
+             *  positions which were actually swapped are stored (in a hash table). The running 
+             *  time and the space are \f$O(k)\f$ instead of \f$O(n)\f$.
+             *
+             *  \param n The size of the universe.
+             *  \param k The number of elements to draw, \f$1 \le k \le n\f$.
+             *  \param a The sampled elements in positions \f$0, \ldots, k-1\f$.
+             */
+            void Subset( int n, int k, leda::array<int>& a );
+
+            /*! \brief Draw a Bernoulli trial.
+             *  \param p The success probability.
+             *  \return True with probability \f$p\f$.
+             */
+            bool Bernoulli( double p )
+            {
+                double ch;
+                randomSource >> ch;
+                return ch <= p;
+            }
+
+            /*! \brief Draw the number of successes before the first failure.
+             *
+             *  The result is geometrically distributed, i.e. it is \f$r\f$ with probability 
+             *  \f$p^r (1-p)\f$. A single random number is used (inversion method).
+             *
+             *  \param p The success probability, \f$0 \le p \le 1\f$.
+             *  \param bound The result is never larger than this value.
+             *  \return The length of the run of successes.
+             */
+            int GeometricRun( double p, int bound );
+
+            /*! \brief Assign ranks to a preference list with random ties.
+             *
+             *  The first entry gets rank 1 and every following entry is tied to its predecessor 
+             *  with probability \f$t\f$, otherwise its rank is increased by one. Instead of one
+             *  random trial per entry, the lengths of the runs of tied entries are drawn directly
+             *  from the geometric distribution and the ranks are filled blockwise. The cost is 
+             *  therefore one random number per distinct rank.
+             *
+             *  \param k The length of the preference list.
+             *  \param t The tie probability, \f$0 \le t \le 1\f$.
+             *  \param ranks The ranks of the entries in positions \f$0, \ldots, k-1\f$.
+             */
+            void TiedRanks( int k, double t, leda::array<int>& ranks );
+
+            /*! \brief Draw from a discrete distribution.
+             *
+             *  A single random number selects both the column of the alias table
+             *  and the side of the column.
+             *
+             *  \param t The prepared distribution, with at least one outcome.
+             *  \return An outcome \f$i\f$ of the table, \f$0 \le i < t.Size()\f$.
+             */
+            int Discrete( const AliasTable& t )
+            {
+                double u;
+                randomSource >> u;
+                int k = t.prob.size();
+                u *= k;
+                int i = (int) u;
+                if ( i >= k ) 
+                    i = k - 1;
+                return ( u - i < t.prob[i] ) ? i : t.alias[i];
+            }
+
+        private:
+            leda::random_source& randomSource;
+    };
+
+}
+
+#endif  // LEP_SAMPLING_H
+
+/* ex: set ts=4 sw=4 sts=4 et: */
@@ -0,0 +1,207 @@
+//
+// This program can be freely used in an academic environment
+// ONLY for research purposes, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    an acknowledgment in the product documentation is required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// Any other use is strictly prohibited by the author, without an explicit
+// permission.
+//
+// Note that this program uses the LEDA library, which is NOT free. For more
+// details visit Algorithmic Solutions at http://www.algorithmic-solutions.com/
+//
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+// ! Any commercial use of this software is strictly !
+// ! prohibited without explicit permission by the   !
+// ! author.                                         !
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// Copyright (C) 2004-2010 Dimitrios Michail <dimitrios.michail@gmail.com>
+//
+
+/*! \file stats.h
+ *  \brief Runtime statistics of the matching algorithms.
+ *
+ *  \ingroup stats
+ */
+
+#ifndef LEP_STATS_H
+#define LEP_STATS_H
+
+#include <LEP/mosp/config.h>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace mosp
+{
+
+    /*! \brief Statistics of a single phase of a matching algorithm.
+     *
+     *  Counters which are not meaningful for a particular algorithm stay zero.
+     *  All times are wall clock times in seconds.
+     *
+     *  \ingroup stats
+     */
+    struct PhaseStats
+    {
+        /*! \brief The phase number. For rank-maximal matchings this is the rank 
+         *         of the edges which were added in this phase. */
+        int phase;
+
+        /*! \brief Number of edges added to the working graph. */
+        int edgesAdded;
+
+        /*! \brief Number of edges removed from the working graph. */
+        int edgesPruned;
+
+        /*! \brief Number of even nodes of the decomposition computed in this phase. */
+        int even;
+
+        /*! \brief Number of odd nodes of the decomposition computed in this phase. */
+        int odd;
+
+        /*! \brief Number of unreached nodes of the decomposition computed in this phase. */
+        int unreached;
+
+        /*! \brief Number of Hopcroft-Karp rounds (shortest augmenting path layerings). */
+        int hkRounds;
+
+        /*! \brief Number of single augmenting path searches, used once few augmentations remain. */
+        int singlePathSearches;
+
+        /*! \brief Number of augmenting paths. */
+        int augmentations;
+
+        /*! \brief Time spent in computing the decomposition. */
+        double partitionTime;
+
+        /*! \brief Time spent in pruning and adding edges. */
+        double pruneTime;
+
+        /*! \brief Time spent in computing the maximum matching. */
+        double matchingTime;
+
+        /*! \brief Bytes of edge data read from external memory. */
+        size_t bytesRead;
+
+        /*! \brief Bytes of edge data written to external memory. */
+        size_t bytesWritten;
+
+        /*! \brief Create an empty phase */
+        PhaseStats( int p = 0 ) : phase( p ), edgesAdded( 0 ), edgesPruned( 0 ), 
+            even( 0 ), odd( 0 ), unreached( 0 ), hkRounds( 0 ), singlePathSearches( 0 ),
+            augmentations( 0 ),
+            partitionTime( 0.0 ), pruneTime( 0.0 ), matchingTime( 0.0 ), 
+            bytesRead( 0 ), bytesWritten( 0 )
+        {
+        }
+    };
+
+    /*! \brief Statistics of a run of a matching algorithm.
+     *
+     *  All algorithms accept an optional pointer to such an object. When the pointer
+     *  is nil nothing is recorded and the only overhead is a pointer comparison per
+     *  phase. Otherwise the object is cleared at the start of the algorithm and one 
+     *  PhaseStats entry is appended for each phase.
+     *
+     *  \ingroup stats
+     */
+    class SolveStats
+    {
+        public:
+
+            /*! \brief Create empty statistics */
+            SolveStats() { Clear(); }
+
+            /*! \brief Forget everything recorded so far */
+            void Clear() 
+            {
+                phases.clear();
+                totalTime = 0.0;
+                algorithm.clear();
+                components = trivialComponents = largestComponent = edgesDominated = 0;
+                stateBytes = 0;
+            }
+
+            /*! \brief Append a new phase
+             *  \param phase The phase number.
+             *  \return The newly created phase, valid until the next call.
+             */
+            PhaseStats& NewPhase( int phase )
+            {
+                phases.push_back( PhaseStats( phase ) );
+                return phases.back();
+            }
+
+            /*! \brief Total number of edges added over all phases. */
+            int EdgesAdded() const;
+
+            /*! \brief Total number of edges pruned over all phases. */
+            int EdgesPruned() const;
+
+            /*! \brief Total number of Hopcroft-Karp rounds over all phases. */
+            int HKRounds() const;
+
+            /*! \brief Total number of single augmenting path searches over all phases. */
+            int SinglePathSearches() const;
+
+            /*! \brief Total number of augmentations over all phases. */
+            int Augmentations() const;
+
+            /*! \brief Total bytes of edge data read from external memory. */
+            size_t BytesRead() const;
+
+            /*! \brief Total bytes of edge data written to external memory. */
+            size_t BytesWritten() const;
+
+            /*! \brief Print the statistics in a line oriented key=value format.
+             *  \param o The output stream
+             */
+            void Print( std::ostream& o ) const;
+
+            /*! \brief Current wall clock time in seconds. */
+            static double WallClock();
+
+            /*! \brief The phases in the order they were executed. */
+            std::vector<PhaseStats> phases;
+
+            /*! \brief Total running time of the algorithm. */
+            double totalTime;
+
+            /*! \brief The engine used, set by front-ends which select one. */
+            std::string algorithm;
+
+            /*! \brief Number of connected components solved independently, 
+             *         zero if the instance was not decomposed. */
+            int components;
+
+            /*! \brief Number of components solved directly, without an engine. */
+            int trivialComponents;
+
+            /*! \brief Number of edges of the largest component. */
+            int largestComponent;
+
+            /*! \brief Number of edges removed by preprocessing. */
+            int edgesDominated;
+
+            /*! \brief Bytes of solver state allocated by the engine, zero if the 
+             *         engine does not report it. */
+            size_t stateBytes;
+    };
+
+}
+
+#endif  // LEP_STATS_H
+
+/* ex: set ts=4 sw=4 sts=4 et: */
@@ -0,0 +1,251 @@
+//
+// This program can be freely used in an academic environment
+// ONLY for research purposes, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    an acknowledgment in the product documentation is required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// Any other use is strictly prohibited by the author, without an explicit
+// permission.
+//
+// Note that this program uses the LEDA library, which is NOT free. For more
+// details visit Algorithmic Solutions at http://www.algorithmic-solutions.com/
+//
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+// ! Any commercial use of this software is strictly !
+// ! prohibited without explicit permission by the   !
+// ! author.                                         !
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// Copyright (C) 2004-2010 Dimitrios Michail <dimitrios.michail@gmail.com>
+//
+
+/*! \file workspace.h
+ *  \brief Scratch memory of the matching algorithms which can be reused across solves.
+ *
+ *  \ingroup options
+ */
+
+#ifndef LEP_WORKSPACE_H
+#define LEP_WORKSPACE_H
+
+#include <LEP/mosp/config.h>
+#include <cstddef>
+
+namespace mosp
+{
+
+    /*! \brief A monotonic arena for the scratch state of a solve.
+     *
+     *  Memory is handed out by bumping a pointer inside a block and is never 
+     *  freed individually. Release() forgets all allocations but keeps the 
+     *  blocks, so that a workspace which is passed to many solves of similar 
+     *  size reaches a steady state where solving performs no heap allocations 
+     *  for its queues and stacks. If a solve needed more than one block, 
+     *  Release() merges them into a single block of the total size.
+     *
+     *  A workspace serves one solve at a time. The engines call Release() 
+     *  when they start, thus anything allocated before is invalidated.
+     *
+     *  \ingroup options
+     */
+    class Workspace
+    {
+        public:
+
+            /*! \brief Create a workspace
+             *  \param reserve Number of bytes to allocate up front.
+             */
+            Workspace( size_t reserve = 0 );
+
+            ~Workspace();
+
+            /*! \brief Allocate memory suitably aligned for any type
+             *  \param bytes The size of the allocation
+             *  \return The memory, valid until the next Release().
+             */
+            void* Allocate( size_t bytes );
+
+            /*! \brief Forget all allocations, keeping the memory */
+            void Release();
+
+            /*! \brief Number of bytes allocated since the last Release() */
+            size_t Used() const { return used + offset; }
+
+            /*! \brief Largest value of Used() ever observed */
+            size_t Peak() const { return peak > Used() ? peak : Used(); }
+
+            /*! \brief Number of bytes held by the workspace */
+            size_t Capacity() const { return capacity; }
+
+            /*! \brief Number of blocks requested from the heap so far */
+            long HeapAllocations() const { return heapAllocations; }
+
+        private:
+
+            // blocks are kept in a list, the current block first
+            struct Block { 
+                Block* next; 
+                size_t size; 
+            };
+
+            void NewBlock( size_t bytes );
+            void FreeBlocks();
+
+            Block* head;
+            size_t offset;      // bytes used in the current block
+            size_t used;        // bytes used in the other blocks
+            size_t capacity;
+            size_t peak;
+            long heapAllocations;
+
+            // not copyable
+            Workspace( const Workspace& );
+            Workspace& operator=( const Workspace& );
+    };
+
+    /*! \brief A stack of plain values living in a Workspace.
+     *
+     *  The elements are stored contiguously and the storage doubles when full, 
+     *  the old storage is left to the arena. The element type must be 
+     *  copyable by assignment and needs no destructor.
+     *
+     *  \ingroup options
+     */
+    template<class T>
+    class ScratchStack
+    {
+        public:
+
+            /*! \brief Create an empty stack
+             *  \param ws The workspace providing the memory.
+             *  \param reserve Initial capacity.
+             */
+            ScratchStack( Workspace& ws, int reserve = 16 ) 
+                : w( ws ), data( 0 ), n( 0 ), cap( 0 ) 
+            { 
+                grow( reserve ); 
+            }
+
+            /*! \brief Whether the stack is empty */
+            bool empty() const { return n == 0; }
+
+            /*! \brief Number of elements */
+            int size() const { return n; }
+
+            /*! \brief Remove all elements, keeping the storage */
+            void clear() { n = 0; }
+
+            /*! \brief Keep only the first k elements */
+            void truncate( int k ) { if ( k < n ) n = k; }
+
+            /*! \brief Push an element */
+            void push( const T& x ) { 
+                if ( n == cap ) grow( 2 * cap );
+                data[ n++ ] = x; 
+            }
+
+            /*! \brief The most recently pushed element */
+            const T& top() const { return data[ n - 1 ]; }
+
+            /*! \brief Remove and return the most recently pushed element */
+            T pop() { return data[ --n ]; }
+
+            /*! \brief The i-th pushed element, counting from zero */
+            T& operator[]( int i ) { return data[ i ]; }
+
+            /*! \brief The i-th pushed element, counting from zero */
+            const T& operator[]( int i ) const { return data[ i ]; }
+
+        private:
+
+            void grow( int c ) { 
+                if ( c < 16 ) c = 16;
+                T* d = static_cast<T*>( w.Allocate( c * sizeof( T ) ) );
+                for( int i = 0; i < n; ++i ) 
+                    d[ i ] = data[ i ];
+                data = d; 
+                cap = c;
+            }
+
+            Workspace& w;
+            T* data;
+            int n, cap;
+    };
+
+    /*! \brief A first-in first-out queue of plain values living in a Workspace.
+     *
+     *  A ring buffer whose storage doubles when full, see ScratchStack.
+     *
+     *  \ingroup options
+     */
+    template<class T>
+    class ScratchQueue
+    {
+        public:
+
+            /*! \brief Create an empty queue
+             *  \param ws The workspace providing the memory.
+             *  \param reserve Initial capacity.
+             */
+            ScratchQueue( Workspace& ws, int reserve = 16 ) 
+                : w( ws ), data( 0 ), first( 0 ), n( 0 ), mask( 0 ) 
+            { 
+                int c = 16;
+                while( c < reserve ) c *= 2;
+                grow( c );
+            }
+
+            /*! \brief Whether the queue is empty */
+            bool empty() const { return n == 0; }
+
+            /*! \brief Number of elements */
+            int size() const { return n; }
+
+            /*! \brief Remove all elements, keeping the storage */
+            void clear() { n = 0; first = 0; }
+
+            /*! \brief Append an element at the back */
+            void append( const T& x ) { 
+                if ( n > mask ) grow( 2 * ( mask + 1 ) );
+                data[ ( first + n++ ) & mask ] = x;
+            }
+
+            /*! \brief Remove and return the element at the front */
+            T pop() { 
+                T x = data[ first ];
+                first = ( first + 1 ) & mask;
+                --n;
+                return x;
+            }
+
+        private:
+
+            // c is a power of two
+            void grow( int c ) { 
+                T* d = static_cast<T*>( w.Allocate( c * sizeof( T ) ) );
+                for( int i = 0; i < n; ++i ) 
+                    d[ i ] = data[ ( first + i ) & mask ];
+                data = d; 
+                first = 0;
+                mask = c - 1;
+            }
+
+            Workspace& w;
+            T* data;
+            int first, n, mask;
+    };
+
+}
+
+#endif  // LEP_WORKSPACE_H
+
+/* ex: set ts=4 sw=4 sts=4 et: */
@@ -0,0 +1,294 @@
+//
+// This program can be freely used in an academic environment
+// ONLY for research purposes, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    an acknowledgment in the product documentation is required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// Any other use is strictly prohibited by the author, without an explicit
+// permission.
+//
+// Note that this program uses the LEDA library, which is NOT free. For more
+// details visit Algorithmic Solutions at http://www.algorithmic-solutions.com/
+//
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+// ! Any commercial use of this software is strictly !
+// ! prohibited without explicit permission by the   !
+// ! author.                                         !
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// Copyright (C) 2004-2010 Dimitrios Michail <dimitrios.michail@gmail.com>
+//
+
+#ifndef LEP_ALTERNATING_BFS_H
+#define LEP_ALTERNATING_BFS_H
+
+#include <LEP/mosp/config.h>
+#include <LEP/mosp/workspace.h>
+
+#ifdef LEDA_GE_V5
+#include <LEDA/graph/graph.h>
+#include <LEDA/graph/node_array.h>
+#else
+#include <LEDA/graph.h>
+#include <LEDA/node_array.h>
+#endif
+
+namespace mosp
+{
+
+#if defined(LEDA_NAMESPACE)
+    using leda::graph;
+    using leda::node;
+    using leda::edge;
+    using leda::node_array;
+#endif
+
+    // A set of nodes of a graph as one bit per node index, the bits 
+    // live in a workspace.
+    class NodeBitset
+    { 
+        public:
+            NodeBitset( const graph& G, Workspace& ws );
+
+            void insert( node v ) { 
+                int i = index( v );
+                bits[ i >> 5 ] |= 1u << ( i & 31 );
+            }
+
+            void erase( node v ) { 
+                int i = index( v );
+                bits[ i >> 5 ] &= ~( 1u << ( i & 31 ) );
+            }
+
+            bool member( node v ) const { 
+                int i = index( v );
+                return ( bits[ i >> 5 ] >> ( i & 31 ) ) & 1u;
+            }
+
+        private:
+            unsigned int* bits;
+    };
+
+    // Level synchronous breadth first search along alternating paths, 
+    // shared by the decompositions and the Hopcroft-Karp layerings.
+    // 
+    // Even levels, which follow the non matching edges, are expanded 
+    // either top-down by scanning the edges of the frontier, or bottom-up 
+    // by scanning the edges of each unvisited node until a parent in the 
+    // frontier is found. Bottom-up pays off when the frontier is large, 
+    // then top-down mostly scans edges towards visited nodes. The switch 
+    // follows the frontier and unvisited degree sums as in the direction 
+    // optimizing BFS of Beamer et al. Odd levels follow the matching edges 
+    // and always run top-down. 
+    //
+    // A search is a call of Begin(), a Source() call per source node 
+    // and a call of Run() with a rule object which provides
+    //   bool Stop( edge e )             the rest of the adjacency list is 
+    //                                   not part of the graph (rank cutoff)
+    //   bool Follow( edge e, bool odd ) e may be traversed from a node 
+    //                                   of the given parity
+    //   bool Visit( node v, int dist )  v is reached, returning true ends 
+    //                                   the search after the current level
+    //   bool Interrupted()              abandon the search
+    // Directed searches traverse edges from source to target, undirected 
+    // ones in both directions.
+    class AlternatingBFS
+    { 
+        public:
+            AlternatingBFS( graph& G, Workspace& ws, bool directed = false );
+
+            // start a new search
+            void Begin();
+
+            // add a source node, at distance zero
+            void Source( node v );
+
+            // run the search, false if the rule interrupted it
+            template<class Rule> bool Run( Rule& rule );
+
+            bool Reached( node v ) const { return mark[v] == search; }
+
+            int Dist( node v ) const { return dist[v]; }
+
+            // number of levels expanded top-down and bottom-up, over all searches
+            int TopDownLevels() const { return topDown; }
+            int BottomUpLevels() const { return bottomUp; }
+
+        private:
+            // Beamer's thresholds, go bottom-up when the frontier has more 
+            // than 1/ALPHA of the unvisited edges, back to top-down once it 
+            // has fewer than 1/BETA of the nodes
+            enum { ALPHA = 14, BETA = 24 };
+
+            void reach( node w, int d ) { 
+                mark[w] = search; dist[w] = d;
+                visited_degree += G.degree( w );
+                next->push( w );
+            }
+
+            template<class Rule> bool top_down( Rule& rule, int level, bool odd, bool& done );
+            template<class Rule> bool bottom_up( Rule& rule, int level, bool& done );
+
+            graph& G;
+            bool directed;
+            node_array<int> mark;
+            node_array<int> dist;
+            int search;
+            long visited_degree;
+            ScratchStack<node> A, B, rest;
+            bool collected;
+            ScratchStack<node>* frontier;
+            ScratchStack<node>* next;
+            NodeBitset in_frontier;
+            int steps;
+            int topDown, bottomUp;
+    };
+
+    template<class Rule> 
+    bool AlternatingBFS::Run( Rule& rule )
+    { 
+        bool done = false, up = false;
+        const long total_degree = 2L * G.number_of_edges();
+        const int n = G.number_of_nodes();
+
+        // visit the sources
+        for( int i = 0; i < next->size(); ++i ) 
+            if ( rule.Visit( (*next)[i], 0 ) ) 
+                done = true;
+
+        for( int level = 0; ! done && ! next->empty(); ++level ) { 
+            ScratchStack<node>* t = frontier; frontier = next; next = t;
+            next->clear();
+
+            bool odd = ( level & 1 ) != 0;
+            if ( ! odd ) { 
+                long frontier_degree = 0;
+                for( int i = 0; i < frontier->size(); ++i ) 
+                    frontier_degree += G.degree( (*frontier)[i] );
+                long unvisited_degree = total_degree - visited_degree;
+                if ( ! up ) 
+                    up = frontier_degree > unvisited_degree / ALPHA;
+                else 
+                    up = frontier->size() >= n / BETA;
+            }
+
+            bool ok;
+            if ( ! odd && up ) { 
+                ok = bottom_up( rule, level, done );
+                bottomUp++;
+            }
+            else { 
+                ok = top_down( rule, level, odd, done );
+                topDown++;
+            }
+            if ( ! ok ) 
+                return false;
+        }
+        return true;
+    }
+
+    template<class Rule> 
+    bool AlternatingBFS::top_down( Rule& rule, int level, bool odd, bool& done )
+    { 
+        edge e;
+        for( int i = 0; i < frontier->size(); ++i ) { 
+            if ( ( ++steps & 63 ) == 0 && rule.Interrupted() ) 
+                return false;
+
+            node v = (*frontier)[i];
+            if ( directed ) { 
+                forall_out_edges( e, v ) { 
+                    if ( rule.Stop( e ) ) break;
+                    node w = G.target( e );
+                    if ( Reached( w ) || ! rule.Follow( e, odd ) ) continue;
+                    reach( w, level + 1 );
+                    if ( rule.Visit( w, level + 1 ) ) done = true;
+                }
+            }
+            else { 
+                forall_inout_edges( e, v ) { 
+                    if ( rule.Stop( e ) ) break;
+                    node w = G.opposite( e, v );
+                    if ( Reached( w ) || ! rule.Follow( e, odd ) ) continue;
+                    reach( w, level + 1 );
+                    if ( rule.Visit( w, level + 1 ) ) done = true;
+                }
+            }
+        }
+        return true;
+    }
+
+    template<class Rule> 
+    bool AlternatingBFS::bottom_up( Rule& rule, int level, bool& done )
+    { 
+        node v; edge e;
+
+        // the unvisited nodes are collected once per search 
+        if ( ! collected ) { 
+            forall_nodes( v, G ) 
+                if ( ! Reached( v ) ) 
+                    rest.push( v );
+            collected = true;
+        }
+
+        for( int i = 0; i < frontier->size(); ++i ) 
+            in_frontier.insert( (*frontier)[i] );
+
+        bool ok = true;
+        int k = 0;
+        for( int i = 0; i < rest.size(); ++i ) { 
+            node w = rest[i];
+            if ( Reached( w ) ) continue;
+            if ( ( ++steps & 63 ) == 0 && rule.Interrupted() ) { 
+                ok = false;
+                break;
+            }
+
+            bool found = false;
+            if ( directed ) { 
+                forall_in_edges( e, w ) { 
+                    if ( rule.Stop( e ) ) break;
+                    if ( in_frontier.member( G.source( e ) ) && rule.Follow( e, false ) ) { 
+                        found = true;
+                        break;
+                    }
+                }
+            }
+            else { 
+                forall_inout_edges( e, w ) { 
+                    if ( rule.Stop( e ) ) break;
+                    if ( in_frontier.member( G.opposite( e, w ) ) && rule.Follow( e, false ) ) { 
+                        found = true;
+                        break;
+                    }
+                }
+            }
+
+            if ( found ) { 
+                reach( w, level + 1 );
+                if ( rule.Visit( w, level + 1 ) ) done = true;
+            }
+            else 
+                rest[k++] = w;
+        }
+        rest.truncate( k );
+
+        for( int i = 0; i < frontier->size(); ++i ) 
+            in_frontier.erase( (*frontier)[i] );
+        return ok;
+    }
+
+}
+
+#endif  // LEP_ALTERNATING_BFS_H
+
+/* ex: set ts=4 sw=4 sts=4 et: */
@@ -0,0 +1,73 @@
+//
+// This program can be freely used in an academic environment
+// ONLY for research purposes, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    an acknowledgment in the product documentation is required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// Any other use is strictly prohibited by the author, without an explicit
+// permission.
+//
+// Note that this program uses the LEDA library, which is NOT free. For more
+// details visit Algorithmic Solutions at http://www.algorithmic-solutions.com/
+//
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+// ! Any commercial use of this software is strictly !
+// ! prohibited without explicit permission by the   !
+// ! author.                                         !
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// Copyright (C) 2004-2010 Dimitrios Michail <dimitrios.michail@gmail.com>
+//
+
+#ifndef LEP_LEX_MWBM_H
+#define LEP_LEX_MWBM_H
+
+#include <LEP/mosp/config.h>
+
+#ifdef LEDA_GE_V5
+#include <LEDA/graph/graph.h>
+#include <LEDA/graph/edge_array.h>
+#include <LEDA/core/list.h>
+#else
+#include <LEDA/graph.h>
+#include <LEDA/edge_array.h>
+#include <LEDA/list.h>
+#endif
+
+namespace mosp
+{
+
+    // Compute a maximum weight matching of a bipartite graph where the weight 
+    // of each edge is a unit vector of dimension levels and vectors are compared 
+    // lexicographically. The weight of edge e is the unit vector of coordinate 
+    // level[e], coordinate 0 being the most significant one. In other words the 
+    // matching maximizes the number of level 0 edges, subject to this the number 
+    // of level 1 edges and so on.
+    //
+    // The implementation is the primal-dual (Hungarian) algorithm with one 
+    // Dijkstra search per node of A, see the LEDA book, section 7.8. Potentials 
+    // and distances are vectors stored in flat arrays of int's, thus no 
+    // arbitrary precision arithmetic is required. The running time is 
+    // O( levels * n (m + n log n) ) and the space O( levels * n + m ).
+    //
+    // The edges may be directed arbitrarily. 
+    leda::list<leda::edge> LEX_MAX_WEIGHT_BIPARTITE_MATCHING( const leda::graph& G,
+            const leda::list<leda::node>& A, 
+            const leda::list<leda::node>& B,
+            const leda::edge_array<int>& level,
+            int levels );
+
+}
+
+#endif  // LEP_LEX_MWBM_H
+
+/* ex: set ts=4 sw=4 sts=4 et: */
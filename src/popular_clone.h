@@ -55,7 +55,8 @@ namespace mosp
                             const leda::list<leda::node>& A_,
                             const leda::list<leda::node>& B_,
                             const leda::edge_array<int>& rank_,
-                            const leda::node_array<int>& capacity_
+                            const leda::node_array<int>& capacity_,
+                            bool validate = true
                             ); 
 
             leda::graph& getClonedGraph();
@@ -0,0 +1,127 @@
+//
+// This program can be freely used in an academic environment
+// ONLY for research purposes, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    an acknowledgment in the product documentation is required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// Any other use is strictly prohibited by the author, without an explicit
+// permission.
+//
+// Note that this program uses the LEDA library, which is NOT free. For more
+// details visit Algorithmic Solutions at http://www.algorithmic-solutions.com/
+//
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+// ! Any commercial use of this software is strictly !
+// ! prohibited without explicit permission by the   !
+// ! author.                                         !
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// Copyright (C) 2004-2010 Dimitrios Michail <dimitrios.michail@gmail.com>
+//
+
+#ifndef LEP_RANK_WEIGHTS_H
+#define LEP_RANK_WEIGHTS_H
+
+#include <LEP/mosp/config.h>
+#include <vector>
+
+#ifdef LEDA_GE_V5
+#include <LEDA/graph/graph.h>
+#include <LEDA/graph/edge_array.h>
+#include <LEDA/core/list.h>
+#else
+#include <LEDA/graph.h>
+#include <LEDA/edge_array.h>
+#include <LEDA/list.h>
+#endif
+
+// 128-bit weights are used when the compiler provides them, define 
+// MOSP_NO_INT128 to disable
+#if defined(__SIZEOF_INT128__) && ! defined(MOSP_NO_INT128)
+#define MOSP_HAVE_INT128
+#endif
+
+namespace mosp
+{
+
+    // Plan of the edge weights used when reducing the rank-maximal matching 
+    // problem to the maximum weight matching problem. 
+    //
+    // Only the ranks which actually appear are kept, mapped to consecutive 
+    // levels with level 0 being the best rank. Level l gets a weight larger 
+    // than the largest total weight that edges of levels l+1,...,levels-1 can 
+    // contribute to any matching. For this the number of level j edges in a 
+    // matching is bounded by c_j, the size of a maximum matching using only 
+    // level j edges, and the total number of edges by min(|A|,|B|). The 
+    // planner first uses the cheap bounds c_j <= min(|A_j|,|B_j|) where A_j 
+    // and B_j are the nodes incident to level j edges, and computes the exact 
+    // c_j only if the cheap weights do not fit in a long.
+    //
+    // Finally the narrowest exact number type is chosen: long, 128-bit 
+    // integers if available or vectors of dimension levels compared 
+    // lexicographically. Since LEDA's weighted matching uses numbers up to 
+    // 3C, where C is the maximum weight, this is the bound checked.
+    class RankWeightPlan
+    { 
+        public:
+            enum NumberType { LONG, INT128, VECTOR };
+
+#ifdef MOSP_HAVE_INT128
+            typedef __int128 wide_t;
+#else
+            typedef long wide_t;
+#endif
+
+            // The edges need to be directed from A to B. 
+            RankWeightPlan( const leda::graph& G, 
+                    const leda::list<leda::node>& A, 
+                    const leda::list<leda::node>& B, 
+                    const leda::edge_array<int>& rank );
+
+            NumberType Type() const { return type; }
+
+            int Levels() const { return levels; }
+
+            // level of rank r, -1 if no edge has rank r
+            int LevelOf( int r ) const { return levelOf[ r ]; }
+
+            // bound on the number of edges of level l in any matching
+            int Bound( int l ) const { return bound[ l ]; }
+
+            // true if the exact rank-restricted matching sizes were computed
+            bool ExactBounds() const { return exact; }
+
+            // weight of level l, valid unless the type is VECTOR
+            wide_t Weight( int l ) const { return weight[ l ]; }
+
+        private:
+            void computeCheapBounds( const leda::list<leda::node>& A, 
+                    const leda::list<leda::node>& B, 
+                    const leda::edge_array<int>& rank );
+            void computeExactBounds( const leda::graph& G, 
+                    const leda::edge_array<int>& rank );
+            NumberType computeWeights();
+
+            int levels;
+            int card;
+            bool exact;
+            NumberType type;
+            std::vector<int> levelOf;
+            std::vector<int> bound;
+            std::vector<wide_t> weight;
+    };
+
+}
+
+#endif  // LEP_RANK_WEIGHTS_H
+
+/* ex: set ts=4 sw=4 sts=4 et: */
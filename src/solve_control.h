@@ -0,0 +1,104 @@
+//
+// This program can be freely used in an academic environment
+// ONLY for research purposes, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    an acknowledgment in the product documentation is required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// Any other use is strictly prohibited by the author, without an explicit
+// permission.
+//
+// Note that this program uses the LEDA library, which is NOT free. For more
+// details visit Algorithmic Solutions at http://www.algorithmic-solutions.com/
+//
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+// ! Any commercial use of this software is strictly !
+// ! prohibited without explicit permission by the   !
+// ! author.                                         !
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// Copyright (C) 2004-2010 Dimitrios Michail <dimitrios.michail@gmail.com>
+//
+
+#ifndef LEP_SOLVE_CONTROL_H
+#define LEP_SOLVE_CONTROL_H
+
+#include <LEP/mosp/config.h>
+#include <LEP/mosp/stats.h>
+#include <LEP/mosp/options.h>
+
+namespace mosp
+{
+
+    // The stopping conditions of a solve: time limit, cancel callback and 
+    // progress callback of the options. Once a condition is met the 
+    // control stays stopped and remembers the reason, which Finish() 
+    // reports to the caller.
+    class SolveControl
+    { 
+        public:
+            SolveControl( const SolveOptions& o ) 
+                : options( o ), start( 0.0 ), reason( SOLVE_DONE ), 
+                  active( o.timeLimit > 0.0 || o.progress != 0 || o.cancel != 0 )
+            {
+                if ( active ) 
+                    start = SolveStats::WallClock();
+            }
+
+            // whether the solve should stop now
+            bool Stop() 
+            { 
+                if ( ! active || reason != SOLVE_DONE ) 
+                    return reason != SOLVE_DONE;
+                if ( options.cancel && options.cancel( options.cancelData ) ) 
+                    reason = SOLVE_CANCELLED;
+                else if ( options.timeLimit > 0.0 && 
+                        SolveStats::WallClock() - start >= options.timeLimit ) 
+                    reason = SOLVE_TIME_LIMIT;
+                return reason != SOLVE_DONE;
+            }
+
+            // report the progress after a phase, false if the solve should stop
+            bool Progress( int phase, int matched, int unmatched ) 
+            { 
+                if ( options.progress && reason == SOLVE_DONE ) { 
+                    SolveProgress p;
+                    p.phase = phase;
+                    p.matched = matched;
+                    p.unmatched = unmatched;
+                    p.elapsed = SolveStats::WallClock() - start;
+                    if ( ! options.progress( p, options.progressData ) ) 
+                        reason = SOLVE_CANCELLED;
+                }
+                return ! Stop();
+            }
+
+            SolveStatus Status() const { return reason; }
+
+            // store the outcome where the options ask for it
+            void Finish() const 
+            { 
+                if ( options.status ) 
+                    *options.status = reason;
+            }
+
+        private:
+            const SolveOptions& options;
+            double start;
+            SolveStatus reason;
+            bool active;
+    };
+
+}
+
+#endif  // LEP_SOLVE_CONTROL_H
+
+/* ex: set ts=4 sw=4 sts=4 et: */